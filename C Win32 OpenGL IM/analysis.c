@@ -0,0 +1,315 @@
+#include <stdlib.h>
+#include <ctype.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "analysis.h"
+#include "noguess.h"
+
+typedef struct AnalysisJob{
+	Analysis *analysis;
+	int count;
+	atomic_int next;
+}AnalysisJob;
+
+typedef struct AnalysisTask{
+	AnalysisJob *job;
+	int index;
+}AnalysisTask;
+
+void *analysisWorker(void *data);
+
+// setup functions
+
+int analysisSetup(Analysis *analysis, int threads){
+	analysis->threads = threads > 0 ? threads : gameCpuCount();
+	analysis->ready = 0;
+	analysis->capacity = analysis->threads * ANALYSIS_CHUNK;
+	analysis->boards = analysis->invalid = analysis->failed = analysis->solvable = analysis->guesses = analysis->mostGuesses = analysis->oddsKnown = 0;
+	analysis->progress = analysis->odds = 0.;
+	analysis->board = calloc(analysis->threads, sizeof(Game));
+	analysis->solver = calloc(analysis->threads, sizeof(Solver));
+	analysis->probability = calloc(analysis->threads, sizeof(Probability));
+	analysis->batch = calloc(analysis->capacity, sizeof(AnalysisBoard));
+	analysis->result = calloc(analysis->capacity, sizeof(AnalysisResult));
+	if(analysis->board == NULL || analysis->solver == NULL || analysis->probability == NULL || analysis->batch == NULL || analysis->result == NULL)
+		return -1;
+	for(; analysis->ready < analysis->threads; analysis->ready++){
+		Game *board = &analysis->board[analysis->ready];
+		solverSetup(&analysis->solver[analysis->ready]);
+		probabilitySetup(&analysis->probability[analysis->ready]);
+		analysis->probability[analysis->ready].threads = 1;
+		if(gameBoardSetup(board, 1, 1, 0)) // resized to each board by analysisLoad
+			return -1;
+		board->trackFrontier = 1;
+		board->threads = 1;
+	}
+	return 0;
+}
+
+// corpus functions
+
+int64_t analysisRun(Analysis *analysis, FILE *boards, FILE *results){ // boards read, -1 on a malformed board, the boards before it analysed and written
+	int64_t read = 0;
+	int status = 1;
+	while(status == 1){
+		
+		// one round of boards, read on the calling thread
+		int count = 0;
+		while(count < analysis->capacity && (status = analysisRead(boards, &analysis->batch[count])) == 1)
+			analysis->batch[count++].index = read++;
+		if(count == 0)
+			break;
+		
+		// the calling thread works alongside threads - 1 others, each claiming one board at a time as their costs vary
+		AnalysisJob job;
+		job.analysis = analysis;
+		job.count = count;
+		atomic_init(&job.next, 0);
+		pthread_t *worker = malloc(sizeof(pthread_t) * analysis->threads);
+		AnalysisTask *task = malloc(sizeof(AnalysisTask) * analysis->threads);
+		if(worker == NULL || task == NULL){
+			free(worker);
+			free(task);
+			return -1;
+		}
+		for(int t = 0; t < analysis->threads; t++){
+			task[t].job = &job;
+			task[t].index = t;
+		}
+		int started = 1;
+		for(; started < analysis->threads; started++)
+			if(pthread_create(&worker[started], NULL, analysisWorker, &task[started]))
+				break;
+		analysisWorker(&task[0]);
+		for(int t = 1; t < started; t++)
+			pthread_join(worker[t], NULL);
+		free(worker);
+		free(task);
+		
+		// results in file order, and the summary
+		for(int b = 0; b < count; b++){
+			AnalysisResult *result = &analysis->result[b];
+			if(results != NULL)
+				analysisWriteResult(results, &analysis->batch[b], result);
+			analysis->boards++;
+			if(!result->valid){
+				analysis->invalid++;
+				analysis->failed += result->failed;
+				continue;
+			}
+			analysis->solvable += result->guesses == 0;
+			analysis->guesses += result->guesses;
+			if(result->guesses > analysis->mostGuesses)
+				analysis->mostGuesses = result->guesses;
+			analysis->progress += result->safeTiles > 0 ? (double)result->beforeGuess / result->safeTiles : 1.;
+			if(result->odds >= 0.){
+				analysis->odds += result->odds;
+				analysis->oddsKnown++;
+			}
+		}
+	}
+	return status < 0 ? -1 : read;
+}
+
+void *analysisWorker(void *data){
+	AnalysisTask *task = data;
+	AnalysisJob *job = task->job;
+	Analysis *analysis = job->analysis;
+	int b;
+	while((b = atomic_fetch_add(&job->next, 1)) < job->count)
+		analysisBoard(&analysis->board[task->index], &analysis->solver[task->index], &analysis->probability[task->index], &analysis->batch[b], &analysis->result[b]);
+	return NULL;
+}
+
+int analysisRead(FILE *file, AnalysisBoard *board){ // 1 for a board, 0 at the end of the file, -1 on a malformed or cut-off board
+	int64_t value[4];
+	for(int v = 0; v < 4; v++){
+		int got = analysisNumber(file, &value[v]);
+		if(got <= 0)
+			return v == 0 && got == 0 ? 0 : -1;
+	}
+	if(value[0] < 1 || value[0] > 0x7FFFFFFF || value[1] < 1 || value[1] > 0x7FFFFFFF)
+		return -1;
+	
+	// a mine count or first click off the board, checked before the count sizes the mine list
+	int64_t totalTiles = value[0] * value[1];
+	if(value[2] < 0 || value[2] >= totalTiles || value[3] < 0 || value[3] >= totalTiles)
+		return -1;
+	board->width = (int)value[0];
+	board->height = (int)value[1];
+	board->mines = value[2];
+	board->startTile = value[3];
+	if(board->mines > board->mineCapacity){
+		int64_t *mine = realloc(board->mine, sizeof(int64_t) * board->mines);
+		if(mine == NULL)
+			return -1;
+		board->mine = mine;
+		board->mineCapacity = board->mines;
+	}
+	for(int64_t m = 0; m < board->mines; m++)
+		if(analysisNumber(file, &board->mine[m]) <= 0)
+			return -1;
+	return 1;
+}
+
+int analysisNumber(FILE *file, int64_t *value){ // 1 for a number, 0 at the end of the file, -1 on anything else
+	int c = getc(file);
+	while(c == '#' || isspace(c)){
+		if(c == '#')
+			while(c != '\n' && c != EOF)
+				c = getc(file);
+		c = getc(file);
+	}
+	if(c == EOF)
+		return 0;
+	if(!isdigit(c))
+		return -1;
+	*value = 0;
+	for(; isdigit(c); c = getc(file)){
+		if(*value > (INT64_MAX - 9) / 10)
+			return -1;
+		*value = *value * 10 + c - '0';
+	}
+	if(c != EOF)
+		ungetc(c, file);
+	return 1;
+}
+
+void analysisWrite(FILE *file, Game *game, int64_t startTile){ // the board as analysisRead takes it
+	fprintf(file, "%d %d %lld %lld", game->width, game->height, (long long)game->mines, (long long)startTile);
+	for(int64_t t = 0; t < game->totalTiles; t++)
+		if(gameTile(game, t) == -1)
+			fprintf(file, " %lld", (long long)t);
+	fputc('\n', file);
+}
+
+void analysisWriteResult(FILE *file, AnalysisBoard *board, AnalysisResult *result){ // "index solvable guesses beforeGuess safeTiles odds", "index invalid" or "index failed"
+	if(!result->valid)
+		fprintf(file, "%lld %s\n", (long long)board->index, result->failed ? "failed" : "invalid");
+	else
+		fprintf(file, "%lld %d %lld %lld %lld %.6g\n", (long long)board->index, result->guesses == 0, (long long)result->guesses, (long long)result->beforeGuess, (long long)result->safeTiles, result->odds);
+}
+
+// board functions
+
+int analysisLoad(Game *game, AnalysisBoard *board){ // the recorded board in play state, nothing revealed; -1 if the board is invalid, -2 past ANALYSIS_TILES or on allocation failure
+	if((int64_t)board->width * board->height > ANALYSIS_TILES)
+		return -2;
+	if(game->width != board->width || game->height != board->height){
+		game->width = board->width;
+		game->height = board->height;
+		if(gameResize(game)){
+			
+			// left without arrays, so the next board resizes whatever its size
+			game->width = game->height = 0;
+			game->totalTiles = 0;
+			return -2;
+		}
+	}
+	if(board->mines >= game->totalTiles || board->startTile < 0 || board->startTile >= game->totalTiles)
+		return -1;
+	gameClear(game);
+	for(int64_t t = 0; t < game->totalTiles; t++)
+		gameSetTile(game, t, 0);
+	for(int64_t m = 0; m < board->mines; m++){
+		int64_t t = board->mine[m];
+		if(t < 0 || t >= game->totalTiles || gameTile(game, t) == -1 || t == board->startTile)
+			return -1;
+		gameSetTile(game, t, -1);
+	}
+	gameCountMines(game);
+	game->mines = board->mines;
+	game->freeSpace = game->totalTiles - game->mines;
+	game->prepared = 0;
+	game->state = 1;
+	return 0;
+}
+
+void analysisBoard(Game *game, Solver *solver, Probability *probability, AnalysisBoard *board, AnalysisResult *result){
+	int loaded = analysisLoad(game, board);
+	result->valid = loaded == 0;
+	result->failed = loaded == -2;
+	if(!result->valid)
+		return;
+	result->safeTiles = game->freeSpace;
+	result->beforeGuess = -1;
+	result->guesses = 0;
+	result->odds = 1.;
+	
+	// deduction until it stalls, then the best guess that lands, until the board is open
+	gameTileReveal(board->startTile, game);
+	while(1){
+		noGuessPlay(game, solver);
+		if(game->freeSpace == 0)
+			break;
+		double chance;
+		int certain;
+		int64_t guess = analysisGuess(game, probability, &chance, &certain);
+		if(guess < 0)
+			break;
+		int64_t freeSpaceBefore = game->freeSpace; // a guess on a zero floods, opening more than itself
+		gameTileReveal(guess, game);
+		
+		// a tile every layout leaves clear, through the mine total or counts further apart than the solver looks, is no guess
+		if(certain)
+			continue;
+		if(result->beforeGuess < 0)
+			result->beforeGuess = result->safeTiles - freeSpaceBefore;
+		result->guesses++;
+		if(chance < 0. || result->odds < 0.)
+			result->odds = -1.;
+		else
+			result->odds *= chance;
+	}
+	if(result->beforeGuess < 0)
+		result->beforeGuess = result->safeTiles;
+}
+
+int64_t analysisGuess(Game *game, Probability *probability, double *chance, int *certain){ // the hidden safe tile least likely a mine from what is visible, with its chance of being safe, -1 for the chance where probabilities failed, and whether every layout leaves it clear; -1 with no safe tile hidden
+	int known = probabilityRun(probability, game) == 0;
+	int64_t best = -1;
+	double bestProbability = 2.;
+	*certain = 0;
+	for(int64_t t = 0; t < game->totalTiles; t++){
+		if(gameMask(game, t) != 1 || gameTile(game, t) == -1) continue;
+		if(known && probability->certain[t] & PROBABILITY_SAFE){
+			best = t;
+			bestProbability = 0.;
+			*certain = 1;
+			break;
+		}
+		double p = known ? probability->probability[t] : 1.;
+		if(p < bestProbability){
+			best = t;
+			bestProbability = p;
+			if(!known)
+				break;
+		}
+	}
+	*chance = known ? 1. - bestProbability : -1.;
+	return best;
+}
+
+// cleanup functions
+
+void analysisCleanup(Analysis *analysis){
+	for(int w = 0; w < analysis->ready; w++){
+		gameBoardCleanup(&analysis->board[w]);
+		solverCleanup(&analysis->solver[w]);
+		probabilityCleanup(&analysis->probability[w]);
+	}
+	for(int b = 0; analysis->batch != NULL && b < analysis->capacity; b++)
+		free(analysis->batch[b].mine);
+	free(analysis->board);
+	free(analysis->solver);
+	free(analysis->probability);
+	free(analysis->batch);
+	free(analysis->result);
+	analysis->board = NULL;
+	analysis->solver = NULL;
+	analysis->probability = NULL;
+	analysis->batch = NULL;
+	analysis->result = NULL;
+	analysis->ready = 0;
+}
@@ -0,0 +1,75 @@
+#ifndef ANALYSIS
+#define ANALYSIS
+
+#include <stdio.h>
+#include <stdint.h>
+
+#include "board.h"
+#include "solver.h"
+#include "probability.h"
+
+#define ANALYSIS_CHUNK 256 // boards read per thread before a round is analysed and written
+#define ANALYSIS_TILES ((int64_t)1 << 26) // largest board analysed, larger ones are reported as failed
+
+// a board as recorded in a corpus file: "width height mines startTile" then the tile of each mine, '#' starting a comment to the end of the line
+typedef struct AnalysisBoard{
+	int64_t index; // place in the file, from 0
+	int width;
+	int height;
+	int64_t mines;
+	int64_t startTile; // the recorded first click
+	int64_t *mine;
+	int64_t mineCapacity;
+}AnalysisBoard;
+
+typedef struct AnalysisResult{
+	int valid; // 0 for a board with a mine off the board, twice or under the first click
+	int failed; // 1, with valid 0, for a board past ANALYSIS_TILES or one its worker could not allocate
+	int64_t safeTiles;
+	int64_t beforeGuess; // safe tiles open before the first guess, all of them on a solvable board
+	int64_t guesses; // stalls with no tile certainly safe, each resolved by opening the truly safe tile the visible board makes least likely a mine
+	double odds; // chance that every guess lands, -1 where mine probabilities could not be found
+}AnalysisResult;
+
+// deduction from the recorded first click over a stream of boards, on a worker pool
+typedef struct Analysis{
+	int threads;
+	int ready; // workers set up, freed by analysisCleanup
+	Game *board; // per thread, keeping a frontier for solverUpdate
+	Solver *solver;
+	Probability *probability; // single-threaded, the pool already fills the cores
+	AnalysisBoard *batch; // one round of boards and their results
+	AnalysisResult *result;
+	int capacity;
+	
+	// summary over every board analysed
+	long long boards;
+	long long invalid; // failed boards included
+	long long failed;
+	long long solvable;
+	long long guesses;
+	long long mostGuesses;
+	double progress; // sum of beforeGuess / safeTiles
+	double odds; // sum of odds where known
+	long long oddsKnown;
+}Analysis;
+
+// setup
+int analysisSetup(Analysis *analysis, int threads);
+
+// corpus
+int64_t analysisRun(Analysis *analysis, FILE *boards, FILE *results);
+int analysisRead(FILE *file, AnalysisBoard *board);
+int analysisNumber(FILE *file, int64_t *value);
+void analysisWrite(FILE *file, Game *game, int64_t startTile);
+void analysisWriteResult(FILE *file, AnalysisBoard *board, AnalysisResult *result);
+
+// boards
+int analysisLoad(Game *game, AnalysisBoard *board);
+void analysisBoard(Game *game, Solver *solver, Probability *probability, AnalysisBoard *board, AnalysisResult *result);
+int64_t analysisGuess(Game *game, Probability *probability, double *chance, int *certain);
+
+// cleanup
+void analysisCleanup(Analysis *analysis);
+
+#endif
@@ -0,0 +1,105 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "board.h"
+#include "analysis.h"
+
+int analyzeUsage();
+int analyzeGenerate(int argc, char **argv);
+double analyzeTime();
+
+// command-line functions
+
+int analyzeUsage(){
+	fprintf(stderr, "usage: analyze [-t threads] [-o results] boards\n");
+	fprintf(stderr, "       analyze -g width height mines count seed\n");
+	fprintf(stderr, "boards: \"width height mines startTile\" then each mine's tile, per board (\"-\" reads stdin)\n");
+	fprintf(stderr, "results: \"index solvable guesses beforeGuess safeTiles odds\" per board (\"index invalid\" or \"index failed\" otherwise), summary on stderr\n");
+	return 1;
+}
+
+int analyzeGenerate(int argc, char **argv){ // random boards clicked at their centre, for trying the analysis out
+	if(argc != 7)
+		return analyzeUsage();
+	int width = atoi(argv[2]), height = atoi(argv[3]);
+	long long mines = atoll(argv[4]), count = atoll(argv[5]);
+	uint64_t seed = strtoull(argv[6], NULL, 10);
+	Game game;
+	if(width < 1 || height < 1 || mines < 0 || mines + 9 > (long long)width * height || gameBoardSetup(&game, width, height, mines))
+		return analyzeUsage();
+	int64_t start = width / 2 + (int64_t)(height / 2) * width;
+	for(long long b = 0; b < count; b++){
+		gameSeed(&game, seed + b);
+		gameStart(&game, start);
+		analysisWrite(stdout, &game, start);
+	}
+	gameBoardCleanup(&game);
+	return 0;
+}
+
+double analyzeTime(){
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+int main(int argc, char **argv){
+	if(argc > 1 && strcmp(argv[1], "-g") == 0)
+		return analyzeGenerate(argc, argv);
+	int threads = 0;
+	const char *input = NULL, *output = NULL;
+	for(int a = 1; a < argc; a++){
+		if(strcmp(argv[a], "-t") == 0 && a + 1 < argc)
+			threads = atoi(argv[++a]);
+		else if(strcmp(argv[a], "-o") == 0 && a + 1 < argc)
+			output = argv[++a];
+		else if(input == NULL)
+			input = argv[a];
+		else
+			return analyzeUsage();
+	}
+	if(input == NULL)
+		return analyzeUsage();
+	FILE *boards = strcmp(input, "-") == 0 ? stdin : fopen(input, "r");
+	FILE *results = output == NULL ? stdout : fopen(output, "w");
+	if(boards == NULL || results == NULL){
+		fprintf(stderr, "cannot open %s\n", boards == NULL ? input : output);
+		return 1;
+	}
+	Analysis analysis;
+	if(analysisSetup(&analysis, threads)){
+		fprintf(stderr, "allocation failure\n");
+		return 1;
+	}
+	
+	// results stream out a round at a time, reading and writing included in the time
+	fprintf(results, "# index solvable guesses beforeGuess safeTiles odds\n");
+	double t = analyzeTime();
+	int64_t status = analysisRun(&analysis, boards, results);
+	t = analyzeTime() - t;
+	if(status < 0)
+		fprintf(stderr, "malformed board after board %lld, stopped\n", analysis.boards);
+	
+	// summary
+	long long valid = analysis.boards - analysis.invalid;
+	fprintf(stderr, "%lld boards, %lld invalid, %lld of them failed (past %lld tiles or out of memory)\n", analysis.boards, analysis.invalid, analysis.failed, (long long)ANALYSIS_TILES);
+	if(valid > 0){
+		fprintf(stderr, "  solvable without guessing %12lld (%.2f%%)\n", analysis.solvable, 100. * analysis.solvable / valid);
+		fprintf(stderr, "  guesses per board         %12.3f (most %lld)\n", (double)analysis.guesses / valid, analysis.mostGuesses);
+		fprintf(stderr, "  opened before first guess %11.2f%% of safe tiles\n", 100. * analysis.progress / valid);
+		if(analysis.oddsKnown > 0)
+			fprintf(stderr, "  chance every guess lands  %11.2f%% (over %lld boards)\n", 100. * analysis.odds / analysis.oddsKnown, analysis.oddsKnown);
+	}
+	fprintf(stderr, "  %.3f s, %.1f boards/s on %d threads, %.1f boards/s per thread\n", t, analysis.boards / t, analysis.threads, analysis.boards / t / analysis.threads);
+	
+	if(boards != stdin)
+		fclose(boards);
+	if(results != stdout)
+		fclose(results);
+	analysisCleanup(&analysis);
+	return status < 0;
+}
@@ -0,0 +1,57 @@
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "arena.h"
+
+// setup functions
+
+void arenaSetup(Arena *arena){
+	arena->block = NULL;
+	arena->base = NULL;
+	arena->capacity = 0;
+	arena->used = 0;
+}
+
+int arenaReserve(Arena *arena, size_t size){ // 1 if the block grew, 0 if it already fit, -1 on allocation failure; contents are kept
+	if(size <= arena->capacity)
+		return 0;
+	size_t offset = (uintptr_t)arena->base - (uintptr_t)arena->block;
+	unsigned char *block = realloc(arena->block, size + ARENA_ALIGN - 1);
+	if(block == NULL)
+		return -1;
+	
+	// realign, moving the contents if the new block sits differently against the alignment
+	unsigned char *base = block + (ARENA_ALIGN - (uintptr_t)block % ARENA_ALIGN) % ARENA_ALIGN;
+	if(arena->capacity > 0 && (size_t)(base - block) != offset)
+		memmove(base, block + offset, arena->capacity);
+	arena->block = block;
+	arena->base = base;
+	arena->capacity = size;
+	return 1;
+}
+
+// sub-array functions
+
+size_t arenaSize(size_t size){
+	return (size + ARENA_ALIGN - 1) / ARENA_ALIGN * ARENA_ALIGN;
+}
+
+void arenaReset(Arena *arena){
+	arena->used = 0;
+}
+
+void *arenaTake(Arena *arena, size_t size){ // sub-arrays taken in the same order after a reset land where they were before
+	if(arena->used + arenaSize(size) > arena->capacity)
+		return NULL;
+	void *array = arena->base + arena->used;
+	arena->used += arenaSize(size);
+	return array;
+}
+
+// cleanup functions
+
+void arenaCleanup(Arena *arena){
+	free(arena->block);
+	arenaSetup(arena);
+}
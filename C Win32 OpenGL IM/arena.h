@@ -0,0 +1,28 @@
+#ifndef ARENA
+#define ARENA
+
+#include <stddef.h>
+
+#define ARENA_ALIGN 64 // sub-arrays start on cache line boundaries
+
+// one allocation carved into sub-arrays, whose capacity only grows so that resizing within it costs no allocator calls
+typedef struct Arena{
+	unsigned char *block;
+	unsigned char *base; // block rounded up to ARENA_ALIGN
+	size_t capacity;
+	size_t used;
+}Arena;
+
+// setup
+void arenaSetup(Arena *arena);
+int arenaReserve(Arena *arena, size_t size);
+
+// sub-arrays
+size_t arenaSize(size_t size);
+void arenaReset(Arena *arena);
+void *arenaTake(Arena *arena, size_t size);
+
+// cleanup
+void arenaCleanup(Arena *arena);
+
+#endif
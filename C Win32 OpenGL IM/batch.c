@@ -0,0 +1,86 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "board.h"
+#include "batch.h"
+
+#define BATCH_CHUNK 16 // boards claimed by a worker at a time
+
+typedef struct BatchJob{
+	BoardSpec *spec;
+	uint64_t firstSeed;
+	int count;
+	unsigned char *boards;
+	atomic_int next;
+	atomic_int failed;
+}BatchJob;
+
+void *batchWorker(void *data);
+
+// board functions
+
+size_t batchBoardSize(BoardSpec *spec){
+	return (size_t)spec->width * spec->height;
+}
+
+int batchGenerate(BoardSpec *spec, uint64_t firstSeed, int count, unsigned char *boards, int threads){
+	int64_t tiles = (int64_t)spec->width * spec->height;
+	if(tiles <= spec->mines || spec->startTile < 0 || spec->startTile >= tiles)
+		return -1;
+	BatchJob job;
+	job.spec = spec;
+	job.firstSeed = firstSeed;
+	job.count = count;
+	job.boards = boards;
+	atomic_init(&job.next, 0);
+	atomic_init(&job.failed, 0);
+	
+	// the calling thread works alongside threads - 1 others
+	if(threads <= 0)
+		threads = gameCpuCount();
+	pthread_t *worker = malloc(sizeof(pthread_t) * threads);
+	if(worker == NULL)
+		return -1;
+	int started = 1;
+	for(; started < threads; started++)
+		if(pthread_create(&worker[started], NULL, batchWorker, &job))
+			break;
+	batchWorker(&job);
+	for(int t = 1; t < started; t++)
+		pthread_join(worker[t], NULL);
+	free(worker);
+	
+	return atomic_load(&job.failed) ? -1 : 0;
+}
+
+void *batchWorker(void *data){
+	BatchJob *job = data;
+	BoardSpec *spec = job->spec;
+	size_t boardSize = batchBoardSize(spec);
+	
+	// a Game over the caller's buffer, only the scratch row and block stamps are owned by the worker
+	Game game;
+	if(gameViewSetup(&game, spec->width, spec->height, spec->mines)){
+		gameBoardCleanup(&game);
+		atomic_store(&job->failed, 1);
+		return NULL;
+	}
+	
+	// claim chunks of boards until none are left, board b always uses seed firstSeed + b
+	int first;
+	while((first = atomic_fetch_add(&job->next, BATCH_CHUNK)) < job->count){
+		int last = first + BATCH_CHUNK < job->count ? first + BATCH_CHUNK : job->count;
+		for(int b = first; b < last; b++){
+			game.cell = job->boards + boardSize * b;
+			memset(game.cell, 1 << CELL_MASK_SHIFT, boardSize);
+			gameSeed(&game, job->firstSeed + b);
+			gamePlaceMines(&game, spec->startTile);
+			gameCountMines(&game);
+		}
+	}
+	
+	gameBoardCleanup(&game);
+	return NULL;
+}
@@ -0,0 +1,18 @@
+#ifndef BATCH
+#define BATCH
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct BoardSpec{
+	int width;
+	int height;
+	int64_t mines;
+	int64_t startTile; // first click, kept clear of mines as in gameStart
+}BoardSpec;
+
+// boards
+size_t batchBoardSize(BoardSpec *spec);
+int batchGenerate(BoardSpec *spec, uint64_t firstSeed, int count, unsigned char *boards, int threads);
+
+#endif
@@ -0,0 +1,1902 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "board.h"
+#include "batch.h"
+#include "padded.h"
+#include "world.h"
+#include "solver.h"
+#include "probability.h"
+#include "noguess.h"
+#include "analysis.h"
+
+// int-per-cell board, as stored by Game before the packed cell layout
+typedef struct LegacyBoard{
+	int width;
+	int height;
+	int mines;
+	int totalTiles;
+	int *tile;
+	int *mask;
+	int *revealQueue;
+	int freeSpace;
+}LegacyBoard;
+
+typedef struct BenchSuite{
+	const char *name;
+	void (*run)();
+}BenchSuite;
+
+// timing
+double benchTime();
+void benchReport(const char *name, double seconds, int reps, double cells);
+
+// legacy layout
+int legacySetup(LegacyBoard *board, int width, int height, int mines);
+void legacyStart(LegacyBoard *board, int startTile);
+void legacyPlaceMines(LegacyBoard *board, int startTile);
+void legacyCountMines(LegacyBoard *board);
+void legacyTileReveal(int target, LegacyBoard *board);
+void legacyGetConnectedTiles(int target, LegacyBoard *board, int *pos);
+void legacyCleanup(LegacyBoard *board);
+
+// packed layout with edge-checked neighbours
+void connectedCountMines(Game *game);
+
+// tile draw values as drawUpdate in "game.h" keeps them, without the window and OpenGL
+int redrawValue(Game *game, int64_t i);
+void redrawDirty(Game *game, int *value);
+void redrawAll(Game *game, int *value);
+
+// boards played to where deduction stops, and probabilities over every layout of their hidden tiles
+int64_t playDeduce(Game *game, Solver *solver, Random *random, int64_t freeSpace);
+double exactLayouts(Game *game, int64_t *hidden, int hiddenTotal, int h, int64_t mines, unsigned char *mine, int64_t *counts, int countTotal, double *tally);
+int64_t playSolve(Game *game, Solver *solver, Random *random, int incremental, double *solveTime, double *moveTime, int64_t *steps);
+int frontierValid(Game *game);
+
+// suites
+void benchPacked();
+void benchCount();
+void benchPlacement();
+void benchRandom();
+void benchBatch();
+void benchPadded();
+void benchReveal();
+void benchParallel();
+void benchRegions();
+void benchRelocate();
+void benchEdits();
+void benchWorld();
+void benchSession();
+void benchIndex();
+void benchArena();
+void benchClear();
+void benchDirty();
+void benchSolver();
+void benchProbability();
+void benchFrontier();
+void benchNoGuess();
+void benchAnalysis();
+
+// timing functions
+
+double benchTime(){
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+}
+
+void benchReport(const char *name, double seconds, int reps, double cells){
+	double each = seconds / reps;
+	printf("  %-40s %10.3f ms %12.1f Mcells/s\n", name, each * 1e3, cells / each * 1e-6);
+}
+
+// legacy layout functions
+
+int legacySetup(LegacyBoard *board, int width, int height, int mines){
+	board->width = width;
+	board->height = height;
+	board->mines = mines;
+	board->totalTiles = width * height;
+	board->tile = malloc(sizeof(int) * board->totalTiles);
+	board->mask = malloc(sizeof(int) * board->totalTiles);
+	board->revealQueue = malloc(sizeof(int) * board->totalTiles);
+	if(board->tile == NULL || board->mask == NULL || board->revealQueue == NULL)
+		return -1;
+	for(int i = 0; i < board->totalTiles; i++)
+		board->mask[i] = 1;
+	return 0;
+}
+
+void legacyStart(LegacyBoard *board, int startTile){
+	for(int t = 0; t < board->totalTiles; t++)
+		board->tile[t] = 0;
+	
+	legacyPlaceMines(board, startTile);
+	board->freeSpace = board->totalTiles - board->mines;
+	legacyCountMines(board);
+}
+
+void legacyPlaceMines(LegacyBoard *board, int startTile){
+	int safezone[9];
+	legacyGetConnectedTiles(startTile, board, (int*)&safezone);
+	safezone[8] = startTile;
+	int bombs = 0;
+	while(bombs < board->mines){
+		int bombPos = rand() % board->totalTiles;
+		int setBomb = 1;
+		for(int z = 0; z < 9; z++){
+			if(bombPos == safezone[z] || board->tile[bombPos] == -1){
+				setBomb = 0;
+				break;
+			}
+		}
+		if(setBomb)
+			board->tile[bombPos] = -1;
+		bombs += setBomb;
+	}
+}
+
+void legacyCountMines(LegacyBoard *board){
+	for(int t = 0; t < board->totalTiles; t++){
+		if(board->tile[t] == -1) continue;
+		
+		int point[8];
+		legacyGetConnectedTiles(t, board, (int*)&point);
+		
+		int count = 0;
+		for(int p = 0; p < 8; p++){
+			if(point[p] != -1)
+				count += (board->tile[point[p]] == -1 ? 1 : 0);
+		}
+		board->tile[t] = count;
+	}
+}
+
+void legacyTileReveal(int target, LegacyBoard *board){
+	board->mask[target] = 0;
+	int *reveal = board->revealQueue;
+	reveal[0] = target;
+	int queueSize = 1;
+	
+	int spaceFreed;
+	for(spaceFreed = 0; spaceFreed < queueSize; spaceFreed++){
+		if(board->tile[reveal[spaceFreed]] == 0){
+			int pos[8];
+			legacyGetConnectedTiles(reveal[spaceFreed], board, (int*)&pos);
+			for(int i = 0; i < 8; i++){
+				if(pos[i] >= 0 && board->mask[pos[i]] == 1){
+					reveal[queueSize++] = pos[i];
+					board->mask[pos[i]] = 0;
+				}
+			}
+		}
+	}
+	board->freeSpace -= spaceFreed;
+}
+
+void legacyGetConnectedTiles(int target, LegacyBoard *board, int *pos){
+	pos[0] = target - board->width - 1;
+	pos[1] = target - board->width;
+	pos[2] = target - board->width + 1;
+	pos[3] = target - 1;
+	pos[4] = target + 1;
+	pos[5] = target + board->width - 1;
+	pos[6] = target + board->width;
+	pos[7] = target + board->width + 1;
+	if(target < board->width)
+		pos[0] = pos[1] = pos[2] = -1;
+	if(target >= board->width * board->height - board->width)
+		pos[5] = pos[6] = pos[7] = -1;
+	if(target % board->width == 0)
+		pos[0] = pos[3] = pos[5] = -1;
+	if(target % board->width == board->width - 1)
+		pos[2] = pos[4] = pos[7] = -1;
+}
+
+void legacyCleanup(LegacyBoard *board){
+	free(board->tile);
+	free(board->mask);
+	free(board->revealQueue);
+}
+
+// packed layout functions
+
+void connectedCountMines(Game *game){
+	for(int t = 0; t < game->totalTiles; t++){
+		if(gameTile(game, t) == -1) continue;
+		
+		int64_t point[8];
+		gameGetConnectedTiles(t, game, (int64_t*)&point);
+		
+		int count = 0;
+		for(int p = 0; p < 8; p++){
+			if(point[p] != -1)
+				count += (gameTile(game, point[p]) == -1 ? 1 : 0);
+		}
+		gameSetTile(game, t, count);
+	}
+}
+
+// redraw functions
+
+int redrawValue(Game *game, int64_t i){
+	return gameMask(game, i) == 0 ? (gameTile(game, i) == -1 ? 9 : gameTile(game, i)) : 9 + gameMask(game, i);
+}
+
+void redrawDirty(Game *game, int *value){
+	if(game->dirtyAll)
+		redrawAll(game, value);
+	else{
+		for(int64_t d = 0; d < game->dirtyTotal; d++)
+			value[game->dirty[d]] = redrawValue(game, game->dirty[d]);
+	}
+	gameDirtyReset(game);
+}
+
+void redrawAll(Game *game, int *value){
+	for(int64_t i = 0; i < game->totalTiles; i++)
+		value[i] = redrawValue(game, i);
+}
+
+// play functions
+
+int64_t playDeduce(Game *game, Solver *solver, Random *random, int64_t freeSpace){ // deductions applied until they stop with at most freeSpace safe tiles hidden, returning the random safe openings made before that
+	int64_t openings = 0;
+	while(game->freeSpace > 0){
+		int64_t found = solverRun(solver, game);
+		for(int64_t i = 0; i < solver->safeTotal; i++)
+			if(gameMask(game, solver->safe[i]) == 1)
+				gameTileReveal(solver->safe[i], game);
+		for(int64_t i = 0; i < solver->mineTotal; i++)
+			gameFlag(game, solver->mine[i]);
+		if(found > 0) continue;
+		if(game->freeSpace <= freeSpace) break;
+		
+		// stuck too early: open hidden safe tiles at random, one per ten thousand tiles
+		for(int64_t g = game->totalTiles / 10000 + 1; g > 0 && game->freeSpace > 0; ){
+			int64_t target = randomBelow64(random, game->totalTiles);
+			if(gameMask(game, target) != 1 || gameTile(game, target) == -1) continue;
+			gameTileReveal(target, game);
+			openings++;
+			g--;
+		}
+	}
+	return openings;
+}
+
+double exactLayouts(Game *game, int64_t *hidden, int hiddenTotal, int h, int64_t mines, unsigned char *mine, int64_t *counts, int countTotal, double *tally){ // layouts placing the mines left from hidden[h] on that agree with every count, each adding its mines to tally
+	if(mines == 0){
+		for(int k = 0; k < countTotal; k++){
+			int64_t pos[8];
+			gameGetConnectedTiles(counts[k], game, (int64_t*)&pos);
+			int around = 0;
+			for(int p = 0; p < 8; p++)
+				around += pos[p] >= 0 && (mine[pos[p]] || gameMask(game, pos[p]) == 2);
+			if(around != gameTile(game, counts[k]))
+				return 0.;
+		}
+		for(int i = 0; i < hiddenTotal; i++)
+			tally[i] += mine[hidden[i]];
+		return 1.;
+	}
+	if(hiddenTotal - h < mines)
+		return 0.;
+	mine[hidden[h]] = 1;
+	double layouts = exactLayouts(game, hidden, hiddenTotal, h + 1, mines - 1, mine, counts, countTotal, tally);
+	mine[hidden[h]] = 0;
+	return layouts + exactLayouts(game, hidden, hiddenTotal, h + 1, mines, mine, counts, countTotal, tally);
+}
+
+int64_t playSolve(Game *game, Solver *solver, Random *random, int incremental, double *solveTime, double *moveTime, int64_t *steps){ // a whole board played by deduction and random safe openings, returning the tiles deduced
+	int64_t deduced = 0;
+	while(game->freeSpace > 0){
+		double t = benchTime();
+		int64_t found = incremental ? solverUpdate(solver, game) : solverRun(solver, game);
+		*solveTime += benchTime() - t;
+		(*steps)++;
+		deduced += found;
+		t = benchTime();
+		for(int64_t i = 0; i < solver->safeTotal; i++)
+			if(gameMask(game, solver->safe[i]) == 1)
+				gameTileReveal(solver->safe[i], game);
+		for(int64_t i = 0; i < solver->mineTotal; i++)
+			gameFlag(game, solver->mine[i]);
+		while(found == 0 && game->freeSpace > 0){
+			int64_t target = randomBelow64(random, game->totalTiles);
+			if(gameMask(game, target) != 1 || gameTile(game, target) == -1) continue;
+			gameTileReveal(target, game);
+			found = 1;
+		}
+		*moveTime += benchTime() - t;
+	}
+	return deduced;
+}
+
+int frontierValid(Game *game){ // 1 if the kept frontier holds exactly the revealed counts with a hidden neighbour
+	int64_t live = 0;
+	for(int64_t t = 0; t < game->totalTiles; t++){
+		int on = 0;
+		if(gameMask(game, t) == 0 && gameTile(game, t) > 0){
+			int64_t pos[8];
+			gameGetConnectedTiles(t, game, (int64_t*)&pos);
+			for(int p = 0; p < 8; p++)
+				on |= pos[p] >= 0 && gameMask(game, pos[p]) == 1;
+		}
+		if(on != ((game->frontierMark[t] & FRONTIER_ON) != 0))
+			return 0;
+		live += on;
+	}
+	return live == game->frontierLive;
+}
+
+// suite functions
+
+void benchPacked(){
+	int sizes[3][3] = { { 30, 20, 99 }, { 1000, 1000, 160000 }, { 3000, 3000, 90000 } };
+	for(int s = 0; s < 3; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2];
+		int start = width / 2 + height / 2 * width;
+		int reps = width * height < 10000 ? 2000 : 5;
+		printf("%dx%d, %d mines\n", width, height, mines);
+		
+		Game game;
+		LegacyBoard legacy;
+		if(gameBoardSetup(&game, width, height, mines) || legacySetup(&legacy, width, height, mines)){
+			printf("  allocation failure\n");
+			return;
+		}
+		
+		// generation
+		double t = benchTime();
+		for(int r = 0; r < reps; r++)
+			legacyStart(&legacy, start);
+		benchReport("generate, int layout", benchTime() - t, reps, legacy.totalTiles);
+		t = benchTime();
+		for(int r = 0; r < reps; r++)
+			gameStart(&game, start);
+		benchReport("generate, packed layout", benchTime() - t, reps, game.totalTiles);
+		
+		// reveal the same board from the starting tile in both layouts
+		for(int i = 0; i < game.totalTiles; i++)
+			legacy.tile[i] = gameTile(&game, i);
+		double legacyTime = 0., packedTime = 0.;
+		int legacyFreed = 0, packedFreed = 0;
+		for(int r = 0; r < reps; r++){
+			for(int i = 0; i < legacy.totalTiles; i++)
+				legacy.mask[i] = 1;
+			legacy.freeSpace = 0;
+			t = benchTime();
+			legacyTileReveal(start, &legacy);
+			legacyTime += benchTime() - t;
+			legacyFreed = -legacy.freeSpace;
+			
+			gameClear(&game);
+			game.freeSpace = 0;
+			t = benchTime();
+			gameTileReveal(start, &game);
+			packedTime += benchTime() - t;
+			packedFreed = -game.freeSpace;
+		}
+		benchReport("reveal, int layout", legacyTime, reps, legacyFreed);
+		benchReport("reveal, packed layout", packedTime, reps, packedFreed);
+		printf("  revealed %d cells (%s), %d vs %d bytes per cell\n", packedFreed, packedFreed == legacyFreed ? "match" : "MISMATCH", (int)sizeof(unsigned char), (int)(sizeof(int) * 2));
+		
+		gameBoardCleanup(&game);
+		legacyCleanup(&legacy);
+	}
+}
+
+void benchCount(){
+	int sizes[4][3] = { { 30, 20, 99 }, { 1000, 1000, 160000 }, { 1000, 1000, 10000 }, { 4000, 4000, 2560000 } };
+	for(int s = 0; s < 4; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2];
+		int reps = width * height < 10000 ? 5000 : 10;
+		printf("%dx%d, %d mines\n", width, height, mines);
+		
+		Game game;
+		LegacyBoard legacy;
+		if(gameBoardSetup(&game, width, height, mines) || legacySetup(&legacy, width, height, mines)){
+			printf("  allocation failure\n");
+			return;
+		}
+		gameStart(&game, 0);
+		
+		// count the same mines with the per-cell neighbour scan and the row-wise plane
+		for(int i = 0; i < game.totalTiles; i++)
+			legacy.tile[i] = gameTile(&game, i) == -1 ? -1 : 0;
+		double t = benchTime();
+		for(int r = 0; r < reps; r++)
+			legacyCountMines(&legacy);
+		benchReport("count, per-cell neighbours", benchTime() - t, reps, legacy.totalTiles);
+		t = benchTime();
+		for(int r = 0; r < reps; r++)
+			gameCountMines(&game);
+		benchReport("count, row plane", benchTime() - t, reps, game.totalTiles);
+		
+		int match = 1;
+		for(int i = 0; i < game.totalTiles; i++)
+			match &= gameTile(&game, i) == legacy.tile[i];
+		printf("  tile values %s\n", match ? "match" : "MISMATCH");
+		
+		gameBoardCleanup(&game);
+		legacyCleanup(&legacy);
+	}
+}
+
+void benchPlacement(){
+	int width = 1000, height = 1000;
+	int density[7] = { 1, 10, 25, 50, 75, 90, 99 };
+	int reps = 5;
+	printf("%dx%d, time per mine placed\n", width, height);
+	printf("  %-10s %16s %16s\n", "density", "rejection", "eligible pool");
+	for(int d = 0; d < 7; d++){
+		int mines = width * height / 100 * density[d];
+		int start = width / 2 + height / 2 * width;
+		Game game;
+		LegacyBoard legacy;
+		if(gameBoardSetup(&game, width, height, mines) || legacySetup(&legacy, width, height, mines)){
+			printf("  allocation failure\n");
+			return;
+		}
+		
+		// time placement alone on a cleared board
+		double legacyTime = 0., poolTime = 0.;
+		for(int r = 0; r < reps; r++){
+			for(int i = 0; i < legacy.totalTiles; i++)
+				legacy.tile[i] = 0;
+			double t = benchTime();
+			legacyPlaceMines(&legacy, start);
+			legacyTime += benchTime() - t;
+			
+			for(int i = 0; i < game.totalTiles; i++)
+				gameSetTile(&game, i, 0);
+			t = benchTime();
+			gamePlaceMines(&game, start);
+			poolTime += benchTime() - t;
+		}
+		int placed = 0;
+		for(int i = 0; i < game.totalTiles; i++)
+			placed += gameTile(&game, i) == -1;
+		printf("  %8d%% %13.1f ns %13.1f ns%s\n", density[d], legacyTime / reps / mines * 1e9, poolTime / reps / mines * 1e9, placed == mines ? "" : "  MISCOUNT");
+		
+		gameBoardCleanup(&game);
+		legacyCleanup(&legacy);
+	}
+}
+
+void benchRandom(){
+	int sizes[5][3] = { { 9, 9, 10 }, { 16, 16, 40 }, { 30, 16, 99 }, { 30, 20, 99 }, { 1000, 1000, 160000 } };
+	uint64_t (*generators[2])(Random *random) = { randomLibc, randomXoshiro };
+	printf("  %-22s %16s %16s\n", "board", "rand() boards/s", "xoshiro boards/s");
+	for(int s = 0; s < 5; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2];
+		int reps = width * height < 10000 ? 20000 : 20;
+		Game game;
+		if(gameBoardSetup(&game, width, height, mines)){
+			printf("  allocation failure\n");
+			return;
+		}
+		
+		// full board generation with each generator plugged in
+		double rate[2];
+		for(int g = 0; g < 2; g++){
+			game.random.next = generators[g];
+			gameSeed(&game, 1);
+			double t = benchTime();
+			for(int r = 0; r < reps; r++)
+				gameStart(&game, 0);
+			rate[g] = reps / (benchTime() - t);
+		}
+		
+		// the same seed regenerates the same board
+		int reproducible = 1;
+		gameSeed(&game, 12345);
+		gameStart(&game, 0);
+		unsigned char *first = malloc(game.totalTiles);
+		for(int i = 0; i < game.totalTiles; i++)
+			first[i] = gameTile(&game, i);
+		gameSeed(&game, 12345);
+		gameStart(&game, 0);
+		for(int i = 0; i < game.totalTiles; i++)
+			reproducible &= first[i] == (unsigned char)gameTile(&game, i);
+		free(first);
+		
+		char name[32];
+		snprintf(name, sizeof(name), "%dx%d/%d", width, height, mines);
+		printf("  %-22s %16.0f %16.0f%s\n", name, rate[0], rate[1], reproducible ? "" : "  NOT REPRODUCIBLE");
+		gameBoardCleanup(&game);
+	}
+}
+
+void benchBatch(){
+	BoardSpec specs[3] = { { 30, 16, 99, 0 }, { 30, 20, 99, 0 }, { 1000, 1000, 160000, 0 } };
+	int cpus = gameCpuCount();
+	for(int s = 0; s < 3; s++){
+		BoardSpec *spec = &specs[s];
+		spec->startTile = spec->width / 2 + spec->height / 2 * spec->width;
+		int count = spec->width * spec->height < 10000 ? 100000 : 40;
+		size_t boardSize = batchBoardSize(spec);
+		unsigned char *boards = malloc(boardSize * count);
+		if(boards == NULL){
+			printf("  allocation failure\n");
+			return;
+		}
+		printf("%dx%d, %d mines, %d boards\n", spec->width, spec->height, (int)spec->mines, count);
+		
+		// scaling over thread counts up to twice the cores
+		for(int threads = 1; threads <= cpus * 2; threads *= 2){
+			double t = benchTime();
+			batchGenerate(spec, 1000, count, boards, threads);
+			t = benchTime() - t;
+			printf("  %2d threads %14.0f boards/s\n", threads, count / t);
+		}
+		
+		// batch boards match single boards generated with the same seed
+		Game game;
+		int match = gameBoardSetup(&game, spec->width, spec->height, spec->mines) == 0;
+		for(int b = 0; match && b < count; b += count / 4){
+			gameSeed(&game, 1000 + b);
+			gameStart(&game, spec->startTile);
+			gameSettle(&game);
+			match = memcmp(game.cell, boards + boardSize * b, boardSize) == 0;
+		}
+		printf("  boards %s gameStart\n", match ? "match" : "DO NOT MATCH");
+		gameBoardCleanup(&game);
+		free(boards);
+	}
+}
+
+void benchPadded(){
+	int sizes[3][3] = { { 30, 20, 99 }, { 1000, 1000, 100000 }, { 3000, 3000, 90000 } };
+	for(int s = 0; s < 3; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2];
+		int start = width / 2 + height / 2 * width;
+		int reps = width * height < 10000 ? 5000 : 5;
+		printf("%dx%d, %d mines\n", width, height, mines);
+		
+		Game game;
+		PaddedBoard padded;
+		if(gameBoardSetup(&game, width, height, mines) || paddedSetup(&padded, width, height)){
+			printf("  allocation failure\n");
+			return;
+		}
+		gameSeed(&game, 7);
+		gameStart(&game, start);
+		paddedLoad(&padded, &game);
+		
+		// neighbour counting
+		double t = benchTime();
+		for(int r = 0; r < reps; r++)
+			connectedCountMines(&game);
+		benchReport("count, edge-checked neighbours", benchTime() - t, reps, game.totalTiles);
+		t = benchTime();
+		for(int r = 0; r < reps; r++)
+			paddedCountMines(&padded);
+		benchReport("count, padded border", benchTime() - t, reps, game.totalTiles);
+		
+		// reveal from the starting tile
+		double gameTime = 0., paddedTime = 0.;
+		for(int r = 0; r < reps; r++){
+			gameClear(&game);
+			game.freeSpace = 0;
+			paddedLoad(&padded, &game);
+			t = benchTime();
+			gameTileReveal(start, &game);
+			gameTime += benchTime() - t;
+			t = benchTime();
+			paddedTileReveal(paddedIndex(&padded, start), &padded);
+			paddedTime += benchTime() - t;
+		}
+		benchReport("reveal, edge-checked neighbours", gameTime, reps, -game.freeSpace);
+		benchReport("reveal, padded border", paddedTime, reps, -padded.freeSpace);
+		
+		int match = game.freeSpace == padded.freeSpace;
+		for(int64_t i = 0; i < game.totalTiles; i++)
+			match &= game.cell[i] == padded.cell[paddedIndex(&padded, i)];
+		printf("  boards %s\n", match ? "match" : "DO NOT MATCH");
+		
+		gameBoardCleanup(&game);
+		paddedCleanup(&padded);
+	}
+}
+
+void benchReveal(){
+	int sizes[4][3] = { { 30, 20, 10 }, { 1000, 1000, 1000 }, { 4000, 4000, 100 }, { 4000, 4000, 160000 } };
+	for(int s = 0; s < 4; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2];
+		int start = width / 2 + height / 2 * width;
+		int reps = width * height < 10000 ? 5000 : 3;
+		printf("%dx%d, %d mines\n", width, height, mines);
+		
+		Game game;
+		unsigned char *queueCells = malloc(width * height);
+		if(gameBoardSetup(&game, width, height, mines) || queueCells == NULL){
+			printf("  allocation failure\n");
+			return;
+		}
+		gameSeed(&game, 3);
+		gameStart(&game, start);
+		
+		// the opening from the first click, worst case when mines are sparse
+		double queueTime = 0., spanTime = 0.;
+		int queueFreed = 0, spanFreed = 0;
+		for(int r = 0; r < reps; r++){
+			gameClear(&game);
+			game.freeSpace = 0;
+			double t = benchTime();
+			gameTileRevealQueue(start, &game);
+			queueTime += benchTime() - t;
+			queueFreed = -game.freeSpace;
+			gameSettle(&game);
+			memcpy(queueCells, game.cell, game.totalTiles);
+			
+			gameClear(&game);
+			game.freeSpace = 0;
+			t = benchTime();
+			gameTileRevealSpan(start, &game);
+			spanTime += benchTime() - t;
+			spanFreed = -game.freeSpace;
+		}
+		benchReport("reveal, tile queue", queueTime, reps, queueFreed);
+		benchReport("reveal, row spans", spanTime, reps, spanFreed);
+		gameSettle(&game);
+		int match = queueFreed == spanFreed && memcmp(queueCells, game.cell, game.totalTiles) == 0;
+		printf("  revealed %d tiles, masks %s\n", spanFreed, match ? "match" : "DO NOT MATCH");
+		
+		gameBoardCleanup(&game);
+		free(queueCells);
+	}
+}
+
+void benchParallel(){
+	
+	// differential check against the tile queue on small boards with flags and open tiles scattered over them, handing off to the bands after a few tiles
+	Random random;
+	random.next = randomXoshiro;
+	randomSeed(&random, 5);
+	int boards = 0, mismatches = 0, unlisted = 0, frontier = 1, kept = 0;
+	unsigned char before[4096], listed[4096];
+	for(int b = 0; b < 5000; b++){
+		int width = 2 + randomBelow(&random, 60), height = 2 + randomBelow(&random, 60);
+		int mines = randomBelow(&random, width * height / 4 + 1);
+		Game queue, parallel;
+		if(gameBoardSetup(&queue, width, height, mines) || gameBoardSetup(&parallel, width, height, mines)){
+			printf("  allocation failure\n");
+			return;
+		}
+		gameSeed(&queue, b);
+		gameStart(&queue, randomBelow(&random, queue.totalTiles));
+		for(int m = randomBelow(&random, queue.totalTiles / 8 + 1); m > 0; m--)
+			gameSetMask(&queue, randomBelow(&random, queue.totalTiles), 2 - 2 * randomBelow(&random, 2));
+		int target = randomBelow(&random, queue.totalTiles);
+		if(gameMask(&queue, target) == 1){
+			gameSettle(&queue);
+			gameSettle(&parallel);
+			memcpy(parallel.cell, queue.cell, queue.totalTiles);
+			memcpy(before, queue.cell, queue.totalTiles);
+			parallel.freeSpace = queue.freeSpace;
+			parallel.revealHandoff = randomBelow(&random, 64);
+			parallel.trackFrontier = 1;
+			gameFrontierUpdate(&parallel);
+			gameDirtyReset(&parallel);
+			gameTileRevealQueue(target, &queue);
+			gameTileRevealParallel(target, &parallel, 2 + randomBelow(&random, 7));
+			boards++;
+			gameSettle(&queue);
+			gameSettle(&parallel);
+			mismatches += queue.freeSpace != parallel.freeSpace || memcmp(queue.cell, parallel.cell, queue.totalTiles) != 0;
+			
+			// every opened tile listed for redrawing, and the frontier brought up to date from the lists alone
+			if(!parallel.dirtyAll && !parallel.frontierStale){
+				kept++;
+				memset(listed, 0, parallel.totalTiles);
+				for(int64_t d = 0; d < parallel.dirtyTotal; d++)
+					listed[parallel.dirty[d]] = 1;
+				for(int64_t t = 0; t < parallel.totalTiles; t++)
+					unlisted += parallel.cell[t] != before[t] && !listed[t];
+			}
+			gameFrontierUpdate(&parallel);
+			frontier &= frontierValid(&parallel);
+		}
+		gameBoardCleanup(&queue);
+		gameBoardCleanup(&parallel);
+	}
+	printf("differential against the tile queue: %d boards, %d mismatches\n", boards, mismatches);
+	printf("  dirty list and frontier kept on %d of them, %d opened tiles unlisted, frontier %s\n", kept, unlisted, frontier ? "matches rescans" : "DOES NOT MATCH RESCANS");
+	
+	// small clicks on a board past the threshold stay on the calling thread and keep the dirty list and frontier
+	int cpus = gameCpuCount();
+	{
+		int width = 4000, height = 4000, mines = 3200000, clicks = 2000;
+		Game game;
+		if(gameBoardSetup(&game, width, height, mines)){
+			printf("  allocation failure\n");
+			return;
+		}
+		gameSeed(&game, 4);
+		gameStart(&game, width / 2 + height / 2 * width);
+		game.trackFrontier = 1;
+		game.threads = cpus > 4 ? cpus : 4;
+		gameFrontierUpdate(&game);
+		int64_t opened = game.freeSpace;
+		int whole = 0;
+		double t = benchTime();
+		for(int c = 0; c < clicks; c++){
+			int64_t target = randomBelow64(&random, game.totalTiles);
+			if(gameMask(&game, target) != 1 || gameTile(&game, target) == -1){
+				c--;
+				continue;
+			}
+			gameDirtyReset(&game);
+			gameTileReveal(target, &game);
+			whole += game.dirtyAll || game.frontierStale;
+		}
+		t = benchTime() - t;
+		opened -= game.freeSpace;
+		printf("%dx%d, %d mines, %d clicks on %d threads\n", width, height, mines, clicks, game.threads);
+		printf("  %-40s %10.3f us %10.1f tiles opened\n", "click with the frontier kept, mean", t / clicks * 1e6, (double)opened / clicks);
+		printf("  %d clicks redrew the whole board or rebuilt the frontier\n", whole);
+		gameBoardCleanup(&game);
+	}
+	
+	// thread scaling on boards past the automatic threshold
+	int sizes[2][3] = { { 4000, 4000, 100 }, { 6000, 6000, 360000 } };
+	for(int s = 0; s < 2; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2];
+		int start = width / 2 + height / 2 * width;
+		printf("%dx%d, %d mines\n", width, height, mines);
+		Game game;
+		unsigned char *spanCells = malloc(width * height);
+		if(gameBoardSetup(&game, width, height, mines) || spanCells == NULL){
+			printf("  allocation failure\n");
+			return;
+		}
+		gameSeed(&game, 3);
+		gameStart(&game, start);
+		gameClear(&game);
+		game.freeSpace = 0;
+		double t = benchTime();
+		gameTileRevealSpan(start, &game);
+		benchReport("reveal, row spans", benchTime() - t, 1, -game.freeSpace);
+		gameSettle(&game);
+		memcpy(spanCells, game.cell, game.totalTiles);
+		int spanFreed = -game.freeSpace;
+		
+		for(int threads = 2; threads <= (cpus > 2 ? cpus * 2 : 4); threads *= 2){
+			gameClear(&game);
+			game.freeSpace = 0;
+			t = benchTime();
+			gameTileRevealParallel(start, &game, threads);
+			char name[48];
+			snprintf(name, sizeof(name), "reveal, %d bands%s", threads, memcmp(spanCells, game.cell, game.totalTiles) || -game.freeSpace != spanFreed ? " (MISMATCH)" : "");
+			benchReport(name, benchTime() - t, 1, -game.freeSpace);
+		}
+		gameBoardCleanup(&game);
+		free(spanCells);
+	}
+}
+
+void benchRegions(){
+	int sizes[3][3] = { { 30, 20, 40 }, { 2000, 2000, 480000 }, { 4000, 4000, 80000 } };
+	for(int s = 0; s < 3; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2];
+		int reps = width * height < 10000 ? 2000 : 3;
+		printf("%dx%d, %d mines\n", width, height, mines);
+		
+		Game fill, labelled;
+		if(gameBoardSetup(&fill, width, height, mines) || gameBoardSetup(&labelled, width, height, mines)){
+			printf("  allocation failure\n");
+			return;
+		}
+		labelled.labelRegions = 1;
+		
+		// generation with and without labelling
+		double t = benchTime();
+		for(int r = 0; r < reps; r++){
+			gameSeed(&fill, 11);
+			gameStart(&fill, 0);
+		}
+		benchReport("generate", benchTime() - t, reps, fill.totalTiles);
+		t = benchTime();
+		for(int r = 0; r < reps; r++){
+			gameSeed(&labelled, 11);
+			gameStart(&labelled, 0);
+		}
+		benchReport("generate and label regions", benchTime() - t, reps, labelled.totalTiles);
+		
+		// click one empty tile of every region on both boards
+		int *target = malloc(sizeof(int) * (labelled.regionTotal + 1));
+		int targetTotal = 0;
+		for(int i = 0; i < labelled.totalTiles; i++)
+			if(labelled.region[i] == targetTotal)
+				target[targetTotal++] = i;
+		double fillTime = 0., copyTime = 0., fillWorst = 0., copyWorst = 0.;
+		for(int c = 0; c < targetTotal; c++){
+			t = benchTime();
+			gameTileReveal(target[c], &fill);
+			t = benchTime() - t;
+			fillTime += t;
+			fillWorst = t > fillWorst ? t : fillWorst;
+			t = benchTime();
+			gameTileReveal(target[c], &labelled);
+			t = benchTime() - t;
+			copyTime += t;
+			copyWorst = t > copyWorst ? t : copyWorst;
+		}
+		printf("  %d regions, %d tiles opened\n", targetTotal, (int)(fill.totalTiles - fill.mines - fill.freeSpace));
+		printf("  %-40s %10.3f us mean %10.3f ms worst\n", "click, span fill", fillTime / targetTotal * 1e6, fillWorst * 1e3);
+		printf("  %-40s %10.3f us mean %10.3f ms worst\n", "click, region copy", copyTime / targetTotal * 1e6, copyWorst * 1e3);
+		gameSettle(&fill);
+		gameSettle(&labelled);
+		int match = fill.freeSpace == labelled.freeSpace && memcmp(fill.cell, labelled.cell, fill.totalTiles) == 0;
+		printf("  masks %s\n", match ? "match" : "DO NOT MATCH");
+		
+		free(target);
+		gameBoardCleanup(&fill);
+		gameBoardCleanup(&labelled);
+	}
+}
+
+void benchRelocate(){
+	int sizes[4][3] = { { 30, 20, 99 }, { 1000, 1000, 160000 }, { 5000, 5000, 4000000 }, { 30, 20, 590 } };
+	for(int s = 0; s < 4; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2];
+		int reps = width * height < 10000 ? 2000 : 3;
+		printf("%dx%d, %d mines\n", width, height, mines);
+		Game game;
+		unsigned char *counted = malloc(width * height);
+		if(gameBoardSetup(&game, width, height, mines) || counted == NULL){
+			printf("  allocation failure\n");
+			return;
+		}
+		
+		// first click generating the whole board against one relocating the safezone mines of a prepared board
+		double startTime = 0., prepareTime = 0., relocateTime = 0.;
+		int valid = 1;
+		for(int r = 0; r < reps; r++){
+			int start = (int)((uint64_t)r * 7919 % game.totalTiles);
+			gameClear(&game);
+			double t = benchTime();
+			gameSelect(&game, start);
+			startTime += benchTime() - t;
+			
+			gameClear(&game);
+			t = benchTime();
+			gamePrepare(&game);
+			prepareTime += benchTime() - t;
+			t = benchTime();
+			gameSelect(&game, start);
+			relocateTime += benchTime() - t;
+			
+			// relocated counts agree with a full recount and the mine total is kept
+			int placed = 0;
+			memcpy(counted, game.cell, game.totalTiles);
+			gameCountMines(&game);
+			for(int i = 0; i < game.totalTiles; i++)
+				placed += gameTile(&game, i) == -1;
+			valid &= placed == mines && memcmp(counted, game.cell, game.totalTiles) == 0 && gameTile(&game, start) != -1;
+		}
+		printf("  %-40s %10.3f ms\n", "first click, gameStart", startTime / reps * 1e3);
+		printf("  %-40s %10.3f ms\n", "gamePrepare, in the menu", prepareTime / reps * 1e3);
+		printf("  %-40s %10.3f ms\n", "first click, relocation", relocateTime / reps * 1e3);
+		printf("  relocated boards %s\n", valid ? "valid" : "INVALID");
+		gameBoardCleanup(&game);
+		free(counted);
+	}
+}
+
+void benchEdits(){
+	int sizes[3][3] = { { 30, 20, 99 }, { 1000, 1000, 160000 }, { 5000, 5000, 4000000 } };
+	int editTotal = 1000000;
+	for(int s = 0; s < 3; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2];
+		printf("%dx%d, %d mines, %d edits\n", width, height, mines, editTotal);
+		Game game;
+		unsigned char *original = malloc(width * height);
+		unsigned char *counted = malloc(width * height);
+		MineEdit *edit = malloc(sizeof(MineEdit) * editTotal);
+		if(gameBoardSetup(&game, width, height, mines) || original == NULL || counted == NULL || edit == NULL){
+			printf("  allocation failure\n");
+			return;
+		}
+		gameSeed(&game, 12);
+		gameStart(&game, -1);
+		memcpy(original, game.cell, game.totalTiles);
+		
+		// record a mix of moves, adds and removes that all apply in sequence
+		for(int e = 0; e < editTotal; e++){
+			int kind = e % 4;
+			int from = -1, to = -1;
+			if(kind != 1 || game.mines == game.totalTiles)
+				do from = randomBelow(&game.random, game.totalTiles); while(gameTile(&game, from) != -1);
+			if(kind != 2 && game.mines < game.totalTiles)
+				do to = randomBelow(&game.random, game.totalTiles); while(gameTile(&game, to) == -1);
+			if(from >= 0 && to >= 0)
+				gameMineMove(&game, from, to);
+			else if(from >= 0)
+				gameMineRemove(&game, from);
+			else
+				gameMineAdd(&game, to);
+			edit[e].from = from;
+			edit[e].to = to;
+		}
+		
+		// replay the edits one call at a time, then as one batch
+		memcpy(game.cell, original, game.totalTiles);
+		game.mines = mines;
+		double t = benchTime();
+		for(int e = 0; e < editTotal; e++){
+			if(edit[e].from < 0)
+				gameMineAdd(&game, edit[e].to);
+			else if(edit[e].to < 0)
+				gameMineRemove(&game, edit[e].from);
+			else
+				gameMineMove(&game, edit[e].from, edit[e].to);
+		}
+		double singleTime = benchTime() - t;
+		memcpy(counted, game.cell, game.totalTiles);
+		
+		memcpy(game.cell, original, game.totalTiles);
+		game.mines = mines;
+		t = benchTime();
+		int applied = gameMineApply(&game, edit, editTotal);
+		double batchTime = benchTime() - t;
+		int valid = applied == editTotal && memcmp(counted, game.cell, game.totalTiles) == 0;
+		
+		// edited counts agree with a full recount, which is what each edit would cost without the fix-ups
+		int placed = 0;
+		t = benchTime();
+		gameCountMines(&game);
+		double recountTime = benchTime() - t;
+		for(int i = 0; i < game.totalTiles; i++)
+			placed += gameTile(&game, i) == -1;
+		valid &= placed == game.mines && memcmp(counted, game.cell, game.totalTiles) == 0;
+		
+		printf("  %-40s %10.3f ms %12.1f Medits/s\n", "gameMineAdd/Remove/Move", singleTime * 1e3, editTotal / singleTime * 1e-6);
+		printf("  %-40s %10.3f ms %12.1f Medits/s\n", "gameMineApply", batchTime * 1e3, editTotal / batchTime * 1e-6);
+		printf("  %-40s %10.3f ms\n", "full recount, gameCountMines", recountTime * 1e3);
+		printf("  edited boards %s\n", valid ? "valid" : "INVALID");
+		gameBoardCleanup(&game);
+		free(original);
+		free(counted);
+		free(edit);
+	}
+}
+
+void benchWorld(){
+	double density = 0.16;
+	
+	// chunk generation
+	World world;
+	int chunks = 4096;
+	if(worldSetup(&world, 5, density)){
+		printf("  allocation failure\n");
+		return;
+	}
+	double t = benchTime();
+	for(int c = 0; c < chunks; c++)
+		worldChunk(&world, c % 64 - 32, c / 64 - 32);
+	benchReport("worldChunk, generation", benchTime() - t, chunks, WORLD_CHUNK * WORLD_CHUNK);
+	worldCleanup(&world);
+	
+	// reveals against a Game holding the same mines: regions clear of the window edge must open identically
+	int size = 256, clicks = 300, compared = 0, valid = 1;
+	Game game;
+	if(gameBoardSetup(&game, size, size, 0)){
+		printf("  allocation failure\n");
+		return;
+	}
+	int32_t left = -size / 2, top = -size / 2;
+	for(int y = 0; y < size; y++)
+		for(int x = 0; x < size; x++)
+			gameSetTile(&game, y * size + x, worldIsMine(&world, left + x, top + y) ? -1 : 0);
+	gameCountMines(&game);
+	for(int c = 0; c < clicks; c++){
+		int x = 2 + (c * 7919) % (size - 4), y = 2 + (c * 104729) % (size - 4);
+		if(gameTile(&game, y * size + x) != 0) continue;
+		worldSetup(&world, 5, density);
+		gameClear(&game);
+		game.freeSpace = game.totalTiles;
+		long long revealed = worldTileReveal(&world, left + x, top + y);
+		int leaked = 0;
+		for(int i = 0; i < size; i++)
+			for(int ring = 0; ring < 2; ring++)
+				leaked |= worldMask(&world, left + i, top + ring) == 0 || worldMask(&world, left + i, top + size - 1 - ring) == 0 ||
+					worldMask(&world, left + ring, top + i) == 0 || worldMask(&world, left + size - 1 - ring, top + i) == 0;
+		if(!leaked){
+			gameTileReveal(y * size + x, &game);
+			valid &= revealed == game.totalTiles - game.freeSpace;
+			for(int i = 0; i < game.totalTiles; i++){
+				int x = i % size, y = i / size, edge = x == 0 || y == 0 || x == size - 1 || y == size - 1;
+				valid &= worldMask(&world, left + x, top + y) == gameMask(&game, i) && (edge || worldTile(&world, left + x, top + y) == gameTile(&game, i));
+			}
+			compared++;
+		}
+		worldCleanup(&world);
+	}
+	gameBoardCleanup(&game);
+	printf("  reveals matching a Game board %s (%d regions compared)\n", valid ? "valid" : "INVALID", compared);
+	
+	// exploration: clicks spreading outwards from the origin, memory against a Game covering the same span
+	int walks[3] = { 1000, 10000, 100000 };
+	for(int w = 0; w < 3; w++){
+		if(worldSetup(&world, 9, density)){
+			printf("  allocation failure\n");
+			return;
+		}
+		Random random = { .next = randomXoshiro };
+		randomSeed(&random, 9);
+		int32_t reach = 0;
+		t = benchTime();
+		worldSelect(&world, 0, 0);
+		for(int c = 1; c < walks[w]; c++){
+			int32_t radius = 16 + c / 4;
+			int32_t x = randomBelow(&random, radius * 2) - radius, y = randomBelow(&random, radius * 2) - radius;
+			if(worldIsMine(&world, x, y)) continue;
+			worldTileReveal(&world, x, y);
+			reach = radius > reach ? radius : reach;
+		}
+		double seconds = benchTime() - t;
+		double span = 4. * reach * reach;
+		printf("  %6d clicks: %10.3f ms %12.1f Mtiles/s, %lld tiles revealed, %d chunks, %.1f MB (Game over the %dx%d span: %.1f MB)\n",
+			walks[w], seconds * 1e3, world.revealed / seconds * 1e-6, world.revealed, world.chunkTotal,
+			worldMemory(&world) / 1048576., reach * 2, reach * 2, span * (1 + sizeof(int)) / 1048576.);
+		worldCleanup(&world);
+	}
+}
+
+void benchSession(){
+	double density = 0.16;
+	int clicks = 200000;
+	int limits[4] = { 0, 4096, 1024, 256 };
+	
+	// a player working outwards from the origin in a drifting neighbourhood, so recent chunks are revisited
+	int32_t *click = malloc(sizeof(int32_t) * 2 * clicks);
+	if(click == NULL){
+		printf("  allocation failure\n");
+		return;
+	}
+	Random random = { .next = randomXoshiro };
+	randomSeed(&random, 3);
+	int32_t px = 0, py = 0, dx = 0, dy = 0;
+	for(int c = 0; c < clicks; c++){
+		if(c % 500 == 0){
+			dx = randomBelow(&random, 5) - 2;
+			dy = randomBelow(&random, 5) - 2;
+		}
+		px += dx;
+		py += dy;
+		click[c * 2] = px + randomBelow(&random, 257) - 128;
+		click[c * 2 + 1] = py + randomBelow(&random, 257) - 128;
+	}
+	
+	World full;
+	for(int l = 0; l < 4; l++){
+		World world;
+		if(worldSetup(&world, 21, density) || (limits[l] > 0 && worldSession(&world, limits[l], NULL))){
+			printf("  allocation failure\n");
+			return;
+		}
+		double t = benchTime();
+		worldSelect(&world, 0, 0);
+		for(int c = 1; c < clicks; c++)
+			if(!worldIsMine(&world, click[c * 2], click[c * 2 + 1]))
+				worldTileReveal(&world, click[c * 2], click[c * 2 + 1]);
+		double seconds = benchTime() - t;
+		char name[64];
+		if(limits[l] > 0)
+			sprintf(name, "session of %d chunks", limits[l]);
+		else
+			sprintf(name, "every chunk resident");
+		printf("  %-24s %10.3f ms, %.1f MB resident, %.1f MB spilled, %lld hits, %lld misses, %lld evictions, %lld writes, %lld reads\n",
+			name, seconds * 1e3, worldMemory(&world) / 1048576., (double)world.recordTotal * WORLD_RECORD / 1048576.,
+			world.hits, world.misses, world.evictions, world.spillWrites, world.spillReads);
+		if(limits[l] == 0){
+			full = world;
+			continue;
+		}
+		
+		// every chunk of the unbounded run reads back the same through the session
+		int valid = world.revealed == full.revealed;
+		for(int t = 0; t < full.tableSize; t++){
+			WorldChunk *chunk = full.table[t];
+			if(chunk == NULL) continue;
+			for(int i = 0; i < WORLD_CHUNK * WORLD_CHUNK; i++)
+				valid &= *worldCell(&world, chunk->cx * WORLD_CHUNK + i % WORLD_CHUNK, chunk->cy * WORLD_CHUNK + i / WORLD_CHUNK) == chunk->cell[i];
+		}
+		printf("  %-24s %s\n", "", valid ? "valid" : "INVALID");
+		worldCleanup(&world);
+	}
+	worldCleanup(&full);
+	free(click);
+}
+
+void benchIndex(){
+	
+	// neighbour indices only need the board's shape, so boards past 2^31 tiles are checked without allocating cells
+	int sizes[3][2] = { { 30, 20 }, { 46341, 46341 }, { 100000, 50000 } };
+	int calls = 10000000;
+	for(int s = 0; s < 3; s++){
+		Game game;
+		game.width = sizes[s][0];
+		game.height = sizes[s][1];
+		game.totalTiles = (int64_t)game.width * game.height;
+		Random random = { .next = randomXoshiro };
+		randomSeed(&random, 4);
+		int valid = 1;
+		int64_t checksum = 0;
+		double t = benchTime();
+		for(int c = 0; c < calls; c++){
+			int64_t target = c & 1 ? randomBelow64(&random, game.totalTiles) : game.totalTiles - 1 - (c >> 1) % game.totalTiles;
+			int64_t pos[8];
+			gameGetConnectedTiles(target, &game, (int64_t*)&pos);
+			for(int p = 0; p < 8; p++)
+				checksum += pos[p];
+			if(c % 64 != 0) continue;
+			
+			// reference from the row and column in 64-bit arithmetic
+			int64_t x = target % game.width, y = target / game.width;
+			for(int p = 0; p < 8; p++){
+				int dx = p == 0 || p == 3 || p == 5 ? -1 : p == 1 || p == 6 ? 0 : 1;
+				int dy = p < 3 ? -1 : p < 5 ? 0 : 1;
+				int inside = x + dx >= 0 && x + dx < game.width && y + dy >= 0 && y + dy < game.height;
+				valid &= pos[p] == (inside ? (y + dy) * game.width + x + dx : -1);
+			}
+		}
+		double seconds = benchTime() - t;
+		printf("%dx%d, %lld tiles (%s indices)\n", game.width, game.height, (long long)game.totalTiles, game.totalTiles <= GAME_FAST_TILES ? "32-bit" : "64-bit");
+		printf("  %-40s %10.3f ns %12.1f Mcalls/s\n", "gameGetConnectedTiles", seconds / calls * 1e9, calls / seconds * 1e-6);
+		printf("  neighbours %s (checksum %lld)\n", valid ? "valid" : "INVALID", (long long)checksum);
+	}
+}
+
+void benchArena(){
+	int presets[4][3] = { { 9, 9, 10 }, { 16, 16, 40 }, { 30, 16, 99 }, { 30, 20, 99 } };
+	int cycles = 20000;
+	
+	// switching settings between presets, on one Game against a fresh Game for each switch; the kept Game tracks a frontier, grown on its first cycle through the presets
+	Game game;
+	if(gameBoardSetup(&game, 30, 20, 99)){
+		printf("  allocation failure\n");
+		return;
+	}
+	game.trackFrontier = 1;
+	int setupAllocations = game.allocations;
+	int warmAllocations = 0;
+	double t = benchTime();
+	for(int c = 0; c < cycles; c++){
+		int *preset = presets[c % 4];
+		game.width = preset[0];
+		game.height = preset[1];
+		game.mines = preset[2];
+		if(gameResize(&game)){
+			printf("  allocation failure\n");
+			return;
+		}
+		gameClear(&game);
+		gamePrepare(&game);
+		int64_t start = preset[0] / 2 + preset[1] / 2 * preset[0];
+		gameRelocate(&game, start);
+		gameTileReveal(start, &game);
+		if(gameFrontierUpdate(&game)){
+			printf("  allocation failure\n");
+			return;
+		}
+		if(c == 3)
+			warmAllocations = game.allocations;
+	}
+	double reuseTime = benchTime() - t;
+	
+	t = benchTime();
+	for(int c = 0; c < cycles; c++){
+		int *preset = presets[c % 4];
+		Game fresh;
+		if(gameBoardSetup(&fresh, preset[0], preset[1], preset[2])){
+			printf("  allocation failure\n");
+			return;
+		}
+		gamePrepare(&fresh);
+		gameBoardCleanup(&fresh);
+	}
+	double freshTime = benchTime() - t;
+	
+	printf("%d switches between 9x9, 16x16, 30x16 and 30x20\n", cycles);
+	printf("  %-40s %10.3f us\n", "gameResize, arena reused", reuseTime / cycles * 1e6);
+	printf("  %-40s %10.3f us\n", "gameBoardSetup and cleanup", freshTime / cycles * 1e6);
+	printf("  %d allocator calls at setup, %d over the first four switches, %d over every later one\n", setupAllocations, warmAllocations - setupAllocations, game.allocations - warmAllocations);
+	gameBoardCleanup(&game);
+}
+
+void benchClear(){
+	int sizes[3][3] = { { 30, 20, 99 }, { 1000, 1000, 150000 }, { 4000, 4000, 2400000 } };
+	for(int s = 0; s < 3; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2];
+		int start = width / 2 + height / 2 * width;
+		int reps = width * height < 10000 ? 100000 : width * height < 2000000 ? 200 : 20;
+		printf("%dx%d, %d mines\n", width, height, mines);
+		Game game;
+		if(gameBoardSetup(&game, width, height, mines)){
+			printf("  allocation failure\n");
+			return;
+		}
+		gameSeed(&game, 6);
+		gameStart(&game, start);
+		gameTileReveal(start, &game);
+		
+		// clearing alone, against clearing and hiding every mask as a full pass did
+		double t = benchTime();
+		for(int r = 0; r < reps; r++)
+			gameClear(&game);
+		printf("  %-40s %10.3f ns\n", "gameClear, epoch stamps", (benchTime() - t) / reps * 1e9);
+		t = benchTime();
+		for(int r = 0; r < reps; r++){
+			gameClear(&game);
+			gameSettle(&game);
+		}
+		benchReport("gameClear and full mask pass", benchTime() - t, reps, game.totalTiles);
+		
+		// restarting the same board: clear, one click, then a flag
+		t = benchTime();
+		for(int r = 0; r < reps; r++){
+			gameClear(&game);
+			game.freeSpace = game.totalTiles - game.mines;
+			gameTileReveal(start, &game);
+			gameSetMask(&game, r % game.totalTiles, 2);
+		}
+		benchReport("restart, click and flag", benchTime() - t, reps, game.totalTiles);
+		
+		// every mask reads hidden after a clear, including across the epoch wrapping, with tiles kept
+		gameSettle(&game);
+		int valid = 1;
+		for(int wrap = 0; wrap < 2; wrap++){
+			if(wrap)
+				game.epoch = UINT_MAX;
+			gameTileReveal(start, &game);
+			unsigned char *tiles = malloc(game.totalTiles);
+			if(tiles == NULL){
+				printf("  allocation failure\n");
+				return;
+			}
+			for(int64_t i = 0; i < game.totalTiles; i++)
+				tiles[i] = game.cell[i] & CELL_TILE;
+			gameClear(&game);
+			for(int64_t i = 0; i < game.totalTiles; i++)
+				valid &= gameMask(&game, i) == 1 && gameTile(&game, i) == (tiles[i] == CELL_MINE ? -1 : tiles[i]);
+			free(tiles);
+		}
+		printf("  masks after clear %s\n", valid ? "valid" : "INVALID");
+		gameBoardCleanup(&game);
+	}
+}
+
+void benchDirty(){
+	int sizes[3][3] = { { 30, 20, 99 }, { 2000, 2000, 600000 }, { 4000, 4000, 2400000 } };
+	for(int s = 0; s < 3; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2];
+		int start = width / 2 + height / 2 * width;
+		int reps = width * height < 10000 ? 100000 : 20;
+		printf("%dx%d, %d mines\n", width, height, mines);
+		Game game;
+		int *value = malloc(sizeof(int) * width * height);
+		int *reference = malloc(sizeof(int) * width * height);
+		if(gameBoardSetup(&game, width, height, mines) || value == NULL || reference == NULL){
+			printf("  allocation failure\n");
+			return;
+		}
+		gameSeed(&game, 8);
+		gameStart(&game, start);
+		gameTileReveal(start, &game);
+		redrawDirty(&game, value);
+		
+		// one flag toggle then a redraw, of the listed tiles against every tile
+		int64_t hidden = 0;
+		while(gameMask(&game, hidden) != 1)
+			hidden++;
+		double t = benchTime();
+		for(int r = 0; r < reps; r++){
+			gameFlag(&game, hidden);
+			redrawDirty(&game, value);
+		}
+		printf("  %-40s %10.3f us\n", "flag and redraw, dirty tiles", (benchTime() - t) / reps * 1e6);
+		t = benchTime();
+		for(int r = 0; r < reps; r++){
+			gameFlag(&game, hidden);
+			redrawAll(&game, value);
+		}
+		printf("  %-40s %10.3f us\n", "flag and redraw, every tile", (benchTime() - t) / reps * 1e6);
+		
+		// random play redrawn from the dirty list matches a full redraw after every move
+		Random random = { .next = randomXoshiro };
+		randomSeed(&random, 9);
+		int valid = 1;
+		for(int round = 0; round < 4; round++){
+			gameClear(&game);
+			gameSeed(&game, round);
+			gameStart(&game, start);
+			for(int m = 0; m < 200; m++){
+				int64_t target = randomBelow64(&random, game.totalTiles);
+				int move = randomBelow(&random, 8);
+				if(move < 4)
+					gameFlag(&game, target);
+				else if(move < 7 && gameMask(&game, target) == 1 && gameTile(&game, target) != -1)
+					gameSelect(&game, target);
+				else
+					gameMineMove(&game, target, randomBelow64(&random, game.totalTiles));
+				redrawDirty(&game, value);
+				if(m % 50 == 49 || s == 0){
+					redrawAll(&game, reference);
+					valid &= memcmp(value, reference, sizeof(int) * game.totalTiles) == 0;
+				}
+			}
+			gameShowBombs(&game);
+			redrawDirty(&game, value);
+			redrawAll(&game, reference);
+			valid &= memcmp(value, reference, sizeof(int) * game.totalTiles) == 0;
+		}
+		printf("  dirty redraws %s\n", valid ? "valid" : "INVALID");
+		
+		gameBoardCleanup(&game);
+		free(value);
+		free(reference);
+	}
+}
+
+void benchSolver(){
+	int sizes[3][3] = { { 30, 16, 99 }, { 1000, 1000, 150000 }, { 2000, 2000, 600000 } };
+	for(int s = 0; s < 3; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2];
+		int start = width / 2 + height / 2 * width;
+		int boards = width * height < 10000 ? 200 : 1;
+		printf("%dx%d, %d mines, %d boards\n", width, height, mines, boards);
+		Game game;
+		Solver solver;
+		solverSetup(&solver);
+		if(gameBoardSetup(&game, width, height, mines) || solverResize(&solver, game.totalTiles)){
+			printf("  allocation failure\n");
+			return;
+		}
+		Random random = { .next = randomXoshiro };
+		randomSeed(&random, 10);
+		
+		// play each board by deduction, opening random safe tiles when it is stuck
+		int valid = 1, solved = 0;
+		long long runs = 0, guesses = 0, deduced = 0;
+		double solveTime = 0., halfTime = 0.;
+		int64_t halfConstraints = 0;
+		for(int b = 0; b < boards; b++){
+			gameClear(&game);
+			gameSeed(&game, b);
+			gameStart(&game, start);
+			gameTileReveal(start, &game);
+			int halfTimed = game.totalTiles < 10000;
+			while(game.freeSpace > 0){
+				
+				// one full solve timed on its own once half the safe tiles are open
+				if(!halfTimed && game.freeSpace < (game.totalTiles - game.mines) / 2){
+					double t = benchTime();
+					for(int r = 0; r < 3; r++)
+						solverRun(&solver, &game);
+					halfTime = (benchTime() - t) / 3;
+					halfConstraints = solver.constraints;
+					halfTimed = 1;
+				}
+				double t = benchTime();
+				int64_t found = solverRun(&solver, &game);
+				solveTime += benchTime() - t;
+				runs++;
+				deduced += found;
+				for(int64_t i = 0; i < solver.safeTotal; i++){
+					valid &= gameTile(&game, solver.safe[i]) != -1;
+					if(gameMask(&game, solver.safe[i]) == 1)
+						gameTileReveal(solver.safe[i], &game);
+				}
+				for(int64_t i = 0; i < solver.mineTotal; i++){
+					valid &= gameTile(&game, solver.mine[i]) == -1;
+					gameFlag(&game, solver.mine[i]);
+				}
+				if(found > 0) continue;
+				
+				// stuck: open hidden safe tiles at random, one per ten thousand tiles
+				for(int64_t g = game.totalTiles / 10000 + 1; g > 0 && game.freeSpace > 0; ){
+					int64_t target = randomBelow64(&random, game.totalTiles);
+					if(gameMask(&game, target) != 1 || gameTile(&game, target) == -1) continue;
+					gameTileReveal(target, &game);
+					guesses++;
+					g--;
+				}
+			}
+			solved += game.freeSpace == 0;
+		}
+		printf("  %-40s %10.3f ms %10lld runs\n", "solve, mean per run", solveTime / runs * 1e3, runs);
+		if(halfConstraints > 0)
+			printf("  %-40s %10.3f ms %10lld counts\n", "solve, half-open board", halfTime * 1e3, (long long)halfConstraints);
+		printf("  %lld tiles deduced, %lld random openings, %d of %d boards cleared\n", deduced, guesses, solved, boards);
+		printf("  deductions %s\n", valid ? "valid" : "INVALID");
+		gameBoardCleanup(&game);
+		solverCleanup(&solver);
+	}
+}
+
+void benchProbability(){
+	Random random = { .next = randomXoshiro };
+	randomSeed(&random, 11);
+	
+	// small boards at random points of play, against every layout of their hidden tiles
+	{
+		int width = 6, height = 6, mines = 7, boards = 300;
+		int start = width / 2 + height / 2 * width;
+		Game game;
+		Solver solver;
+		Probability probability;
+		solverSetup(&solver);
+		probabilitySetup(&probability);
+		if(gameBoardSetup(&game, width, height, mines)){
+			printf("  allocation failure\n");
+			return;
+		}
+		int64_t hidden[36], counts[36];
+		unsigned char mine[36];
+		double tally[36], largestError = 0.;
+		int failed = 0, checked = 0, wrongCertain = 0;
+		for(int b = 0; b < boards; b++){
+			gameClear(&game);
+			gameSeed(&game, b);
+			gameStart(&game, start);
+			gameTileReveal(start, &game);
+			playDeduce(&game, &solver, &random, randomBelow64(&random, game.totalTiles - game.mines));
+			if(game.freeSpace == 0) continue;
+			int hiddenTotal = 0, countTotal = 0;
+			int64_t flags = 0;
+			for(int64_t t = 0; t < game.totalTiles; t++){
+				mine[t] = 0;
+				flags += gameMask(&game, t) == 2;
+				if(gameMask(&game, t) == 1){
+					tally[hiddenTotal] = 0.;
+					hidden[hiddenTotal++] = t;
+				}
+				else if(gameMask(&game, t) == 0 && gameTile(&game, t) > 0)
+					counts[countTotal++] = t;
+			}
+			double layouts = exactLayouts(&game, hidden, hiddenTotal, 0, game.mines - flags, mine, counts, countTotal, tally);
+			if(probabilityRun(&probability, &game) || layouts == 0.){
+				failed++;
+				continue;
+			}
+			for(int i = 0; i < hiddenTotal; i++){
+				double error = fabs(probability.probability[hidden[i]] - tally[i] / layouts);
+				if(error > largestError)
+					largestError = error;
+				
+				// certain exactly where no layout, or every one, puts a mine there
+				int certain = tally[i] == 0. ? PROBABILITY_SAFE : tally[i] == layouts ? PROBABILITY_MINE : 0;
+				wrongCertain += probability.certain[hidden[i]] != certain;
+			}
+			checked++;
+		}
+		printf("%dx%d, %d mines, %d boards\n", width, height, mines, checked);
+		printf("  largest difference from exhaustive layouts %.3g, %d runs failed\n", largestError, failed);
+		printf("  probabilities %s\n", failed == 0 && largestError < 1e-9 ? "exact" : "INEXACT");
+		printf("  certain tiles %s (%d differ from the layouts)\n", failed == 0 && wrongCertain == 0 ? "exact" : "WRONG", wrongCertain);
+		gameBoardCleanup(&game);
+		solverCleanup(&solver);
+		probabilityCleanup(&probability);
+	}
+	
+	// a checkerboard of open counts too wide to sweep, each seeing two mines of its four hidden neighbours so the solver settles none, beside small components that still sweep
+	{
+		int width = 40, height = 40, side = 30, boards = 20;
+		Game game;
+		Probability probability;
+		probabilitySetup(&probability);
+		if(gameBoardSetup(&game, width, height, 0)){
+			printf("  allocation failure\n");
+			return;
+		}
+		int64_t estimated = 0, swept = 0;
+		double largestGap = 0.;
+		int failed = 0, ranged = 1;
+		for(int b = 0; b < boards; b++){
+			gameClear(&game);
+			game.mines = 0;
+			int flip = b % 2;
+			for(int64_t t = 0; t < game.totalTiles; t++){
+				int x = (int)(t % width), y = (int)(t / width);
+				int mine = x < side && y < side ? (x + y) % 2 == 1 && x % 2 == flip : randomBelow(&random, 8) == 0;
+				gameSetTile(&game, t, mine ? -1 : 0);
+				game.mines += mine;
+			}
+			gameCountMines(&game);
+			for(int64_t t = 0; t < game.totalTiles; t++){
+				int x = (int)(t % width), y = (int)(t / width);
+				if((x < side && y < side ? (x + y) % 2 == 0 : x > side && y > side && randomBelow(&random, 8) == 0) && gameTile(&game, t) >= 0)
+					gameSetMask(&game, t, 0);
+			}
+			game.state = 1;
+			if(probabilityRun(&probability, &game)){
+				failed++;
+				continue;
+			}
+			estimated += probability.estimated;
+			swept += probability.componentTotal;
+			double expected = 0.;
+			for(int64_t t = 0; t < game.totalTiles; t++){
+				if(gameMask(&game, t) != 1) continue;
+				expected += probability.probability[t];
+				ranged &= probability.probability[t] >= 0. && probability.probability[t] <= 1.;
+			}
+			if(fabs(expected - game.mines) > largestGap)
+				largestGap = fabs(expected - game.mines);
+		}
+		printf("%dx%d, a %dx%d checkerboard of counts, %d boards\n", width, height, side, side, boards);
+		printf("  %.1f tiles estimated and %.1f components swept per run, %d runs failed, mine total off by at most %.3g\n", (double)estimated / boards, (double)swept / boards, failed, largestGap);
+		printf("  wide components %s\n", failed == 0 && estimated > 0 && swept > 0 && ranged && largestGap < 1e-6 ? "estimated, the rest swept" : "FAIL THE RUN");
+		gameBoardCleanup(&game);
+		probabilityCleanup(&probability);
+	}
+	
+	// boards where deduction stops: once after the first click, and on larger boards with half the safe tiles open
+	int sizes[3][3] = { { 30, 16, 99 }, { 1000, 1000, 150000 }, { 2000, 2000, 600000 } };
+	for(int s = 0; s < 3; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2];
+		int start = width / 2 + height / 2 * width;
+		int boards = width * height < 10000 ? 200 : 1;
+		Game game;
+		Solver solver;
+		Probability probability;
+		solverSetup(&solver);
+		probabilitySetup(&probability);
+		if(gameBoardSetup(&game, width, height, mines)){
+			printf("  allocation failure\n");
+			return;
+		}
+		double runTime = 0., singleTime = 0., largestGap = 0.;
+		int64_t components = 0, largest = 0, states = 0;
+		int widest = 0, failed = 0, agreed = 1;
+		for(int b = 0; b < boards; b++){
+			gameClear(&game);
+			gameSeed(&game, b);
+			gameStart(&game, start);
+			gameTileReveal(start, &game);
+			playDeduce(&game, &solver, &random, boards > 1 ? game.freeSpace : (game.totalTiles - game.mines) / 2);
+			double t = benchTime();
+			if(probabilityRun(&probability, &game)){
+				failed++;
+				continue;
+			}
+			runTime += benchTime() - t;
+			components += probability.componentTotal;
+			states += probability.states;
+			if(probability.largest > largest)
+				largest = probability.largest;
+			if(probability.widest > widest)
+				widest = probability.widest;
+			
+			// the probabilities of every hidden tile add up to the mines left, expected over the layouts
+			double expected = 0.;
+			int64_t left = game.mines;
+			for(int64_t i = 0; i < game.totalTiles; i++){
+				left -= gameMask(&game, i) == 2;
+				if(gameMask(&game, i) == 1)
+					expected += probability.probability[i];
+			}
+			if(fabs(expected - left) > largestGap)
+				largestGap = fabs(expected - left);
+			
+			// one thread, to time the components sweeping in parallel against and check they agree
+			if(b == 0 && probability.threads > 1){
+				double *first = malloc(sizeof(double) * game.totalTiles);
+				if(first != NULL){
+					memcpy(first, probability.probability, sizeof(double) * game.totalTiles);
+					int threads = probability.threads;
+					probability.threads = 1;
+					t = benchTime();
+					agreed &= probabilityRun(&probability, &game) == 0;
+					singleTime = benchTime() - t;
+					probability.threads = threads;
+					agreed &= memcmp(first, probability.probability, sizeof(double) * game.totalTiles) == 0;
+					free(first);
+				}
+			}
+		}
+		int ran = boards - failed;
+		printf("%dx%d, %d mines, %d boards\n", width, height, mines, boards);
+		if(ran > 0){
+			printf("  %-40s %10.3f ms %10.1f components\n", "probabilities, mean per run", runTime / ran * 1e3, (double)components / ran);
+			if(singleTime > 0.)
+				printf("  %-40s %10.3f ms\n", "probabilities, one thread, first board", singleTime * 1e3);
+			printf("  largest component %lld tiles, at most %d counts open, %.1f sweep states per run\n", (long long)largest, widest, (double)states / ran);
+		}
+		printf("  %d runs failed, mine total off by at most %.3g, threads %s\n", failed, largestGap, agreed ? "agree" : "DISAGREE");
+		gameBoardCleanup(&game);
+		solverCleanup(&solver);
+		probabilityCleanup(&probability);
+	}
+}
+
+void benchFrontier(){
+	Random random = { .next = randomXoshiro };
+	
+	// small boards in lockstep: after every move the kept frontier matches a rescan and updates know what full runs deduce, a probability run in between leaving the frontier alone
+	{
+		int width = 30, height = 16, mines = 99, boards = 200;
+		int start = width / 2 + height / 2 * width;
+		Game game;
+		Solver incremental, reference;
+		Probability probability;
+		solverSetup(&incremental);
+		solverSetup(&reference);
+		probabilitySetup(&probability);
+		probability.threads = 1;
+		if(gameBoardSetup(&game, width, height, mines)){
+			printf("  allocation failure\n");
+			return;
+		}
+		game.trackFrontier = 1;
+		randomSeed(&random, 12);
+		int valid = 1, frontier = 1, untouched = 1;
+		int64_t steps = 0, touched = 0, live = 0;
+		for(int b = 0; b < boards; b++){
+			gameClear(&game);
+			gameSeed(&game, b);
+			gameStart(&game, start);
+			gameTileReveal(start, &game);
+			while(game.freeSpace > 0){
+				frontier &= frontierValid(&game);
+				touched += game.touchedTotal;
+				live += game.frontierLive;
+				int64_t changed = game.changedTotal, pending = game.touchedTotal;
+				probabilityRun(&probability, &game);
+				untouched &= game.changedTotal == changed && game.touchedTotal == pending;
+				int64_t found = solverUpdate(&incremental, &game);
+				game.trackFrontier = 0;
+				solverRun(&reference, &game);
+				game.trackFrontier = 1;
+				for(int64_t t = 0; t < game.totalTiles; t++)
+					if(gameMask(&game, t) == 1)
+						valid &= (incremental.state[t] & (SOLVER_SAFE | SOLVER_MINE)) == (reference.state[t] & (SOLVER_SAFE | SOLVER_MINE));
+				steps++;
+				for(int64_t i = 0; i < incremental.safeTotal; i++)
+					if(gameMask(&game, incremental.safe[i]) == 1)
+						gameTileReveal(incremental.safe[i], &game);
+				for(int64_t i = 0; i < incremental.mineTotal; i++)
+					gameFlag(&game, incremental.mine[i]);
+				while(found == 0 && game.freeSpace > 0){
+					int64_t target = randomBelow64(&random, game.totalTiles);
+					if(gameMask(&game, target) != 1 || gameTile(&game, target) == -1) continue;
+					gameTileReveal(target, &game);
+					found = 1;
+				}
+			}
+		}
+		printf("%dx%d, %d mines, %d boards, %lld moves\n", width, height, mines, boards, (long long)steps);
+		printf("  %.1f constraints touched per move, of %.1f on the frontier\n", (double)touched / steps, (double)live / steps);
+		printf("  frontier %s, updates %s\n", frontier ? "matches rescans" : "DOES NOT MATCH RESCANS", valid ? "match full runs" : "DO NOT MATCH FULL RUNS");
+		printf("  probability runs %s\n", untouched ? "leave the frontier alone" : "CHANGE THE FRONTIER");
+		gameBoardCleanup(&game);
+		solverCleanup(&incremental);
+		solverCleanup(&reference);
+		probabilityCleanup(&probability);
+	}
+	
+	// large boards played through twice from the same seeds: full runs on an untracked board, then updates on a tracked one
+	int sizes[2][3] = { { 1000, 1000, 150000 }, { 2000, 2000, 600000 } };
+	for(int s = 0; s < 2; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2];
+		int start = width / 2 + height / 2 * width;
+		Game game;
+		Solver solver;
+		solverSetup(&solver);
+		if(gameBoardSetup(&game, width, height, mines)){
+			printf("  allocation failure\n");
+			return;
+		}
+		printf("%dx%d, %d mines\n", width, height, mines);
+		int64_t deduced[2], steps[2];
+		for(int incremental = 0; incremental <= 1; incremental++){
+			double solveTime = 0., moveTime = 0.;
+			steps[incremental] = 0;
+			game.trackFrontier = incremental;
+			randomSeed(&random, 13);
+			gameClear(&game);
+			gameSeed(&game, 1);
+			gameStart(&game, start);
+			gameTileReveal(start, &game);
+			deduced[incremental] = playSolve(&game, &solver, &random, incremental, &solveTime, &moveTime, &steps[incremental]);
+			printf("  %-40s %10.3f ms %10lld moves\n", incremental ? "solverUpdate, mean per move" : "solverRun, mean per move", solveTime / steps[incremental] * 1e3, (long long)steps[incremental]);
+			printf("  %-40s %10.3f ms\n", incremental ? "moves with the frontier kept, mean" : "moves, mean", moveTime / steps[incremental] * 1e3);
+		}
+		printf("  play %s (%lld and %lld tiles deduced)\n", deduced[0] == deduced[1] && steps[0] == steps[1] ? "matches" : "DIFFERS", (long long)deduced[0], (long long)deduced[1]);
+		gameBoardCleanup(&game);
+		solverCleanup(&solver);
+	}
+}
+
+void benchNoGuess(){
+	int sizes[6][4] = { { 9, 9, 10, 2000 }, { 16, 16, 40, 1000 }, { 30, 16, 99, 200 }, { 50, 50, 400, 50 }, { 100, 100, 1600, 10 }, { 200, 200, 6400, 4 } };
+	for(int s = 0; s < 6; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2], boards = sizes[s][3];
+		int start = width / 2 + height / 2 * width;
+		Game game;
+		Solver solver;
+		NoGuess noGuess;
+		solverSetup(&solver);
+		if(gameBoardSetup(&game, width, height, mines) || noGuessSetup(&noGuess, width, height, mines, 0)){
+			printf("  allocation failure\n");
+			return;
+		}
+		printf("%dx%d, %d mines, %d boards, %d threads\n", width, height, mines, boards, noGuess.threads);
+		
+		// plain boards for comparison, played from the first click until deduction stops
+		int plain = 0;
+		for(int b = 0; b < boards; b++){
+			gameClear(&game);
+			gameSeed(&game, b);
+			gameStart(&game, start);
+			gameTileReveal(start, &game);
+			playDeduce(&game, &solver, NULL, game.totalTiles);
+			plain += game.freeSpace == 0;
+		}
+		
+		// no-guess boards through the first-click hook, each checked by full solver runs from the first click on its own
+		game.generate = noGuessStart;
+		game.generator = &noGuess;
+		double generateTime = 0.;
+		int solvable = 0, failed = 0;
+		for(int b = 0; b < boards; b++){
+			gameClear(&game);
+			gameSeed(&game, b);
+			double t = benchTime();
+			failed += noGuessGenerate(&noGuess, &game, start) != 0;
+			generateTime += benchTime() - t;
+			int64_t placed = 0;
+			for(int64_t i = 0; i < game.totalTiles; i++)
+				placed += gameTile(&game, i) == -1;
+			gameTileReveal(start, &game);
+			playDeduce(&game, &solver, NULL, game.totalTiles);
+			solvable += game.freeSpace == 0 && placed == mines;
+		}
+		printf("  %-40s %10.3f ms %10.1f boards/s\n", "no-guess board, mean", generateTime / boards * 1e3, boards / generateTime);
+		if(noGuess.boards > 0)
+			printf("  %.2f attempts and %.2f mines moved per board, %.2f candidates raced\n", (double)noGuess.attempts / noGuess.boards, (double)noGuess.repairs / noGuess.boards, (double)noGuess.raced / noGuess.boards);
+		printf("  %d of %d plain boards solvable without guessing\n", plain, boards);
+		printf("  %d generations failed, boards %s\n", failed, solvable == boards ? "solvable" : "NOT ALL SOLVABLE");
+		gameBoardCleanup(&game);
+		solverCleanup(&solver);
+		noGuessCleanup(&noGuess);
+	}
+}
+
+void benchAnalysis(){
+	int sizes[4][4] = { { 9, 9, 10, 20000 }, { 16, 16, 40, 10000 }, { 30, 16, 99, 2000 }, { 100, 100, 1600, 40 } };
+	int cpus = gameCpuCount();
+	for(int s = 0; s < 4; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2], count = sizes[s][3];
+		int64_t start = width / 2 + height / 2 * width;
+		Game game;
+		Solver solver;
+		Probability probability;
+		solverSetup(&solver);
+		probabilitySetup(&probability);
+		probability.threads = 1;
+		FILE *boards = tmpfile();
+		int64_t *stall = malloc(sizeof(int64_t) * count);
+		if(boards == NULL || stall == NULL || gameBoardSetup(&game, width, height, mines)){
+			printf("  allocation failure\n");
+			return;
+		}
+		printf("%dx%d, %d mines, %d boards\n", width, height, mines, count);
+		
+		// a corpus as "analyze -g" writes it, recounting the safe tiles open before the first guess on each board apart from the analyzer: full solver runs, then every tile the probabilities make certainly safe at once, until neither opens anything
+		for(int b = 0; b < count; b++){
+			gameClear(&game);
+			gameSeed(&game, b);
+			gameStart(&game, start);
+			analysisWrite(boards, &game, start);
+			gameTileReveal(start, &game);
+			int64_t opened = 1;
+			while(opened > 0){
+				playDeduce(&game, &solver, NULL, game.totalTiles);
+				opened = 0;
+				if(game.freeSpace == 0 || probabilityRun(&probability, &game))
+					break;
+				for(int64_t t = 0; t < game.totalTiles; t++){
+					if(gameMask(&game, t) == 1 && probability.certain[t] & PROBABILITY_SAFE){
+						gameTileReveal(t, &game);
+						opened++;
+					}
+				}
+			}
+			stall[b] = game.totalTiles - mines - game.freeSpace;
+		}
+		
+		// scaling over thread counts up to twice the cores, reading and writing included
+		Analysis first = { 0 };
+		int agree = 1, match = 1;
+		for(int threads = 1; threads <= cpus * 2; threads *= 2){
+			Analysis analysis;
+			FILE *results = tmpfile();
+			if(results == NULL || analysisSetup(&analysis, threads)){
+				printf("  allocation failure\n");
+				return;
+			}
+			rewind(boards);
+			double t = benchTime();
+			int64_t read = analysisRun(&analysis, boards, results);
+			t = benchTime() - t;
+			printf("  %2d threads %14.0f boards/s %12.0f boards/s per thread\n", threads, count / t, count / t / threads);
+			if(threads == 1){
+				
+				// every board opens exactly the recounted safe tiles before its first guess, and is solvable when that is all of them
+				first = analysis;
+				rewind(results);
+				long long index, guesses, before, safe;
+				int solvable;
+				double odds;
+				for(int b = 0; b < count && match; b++){
+					match = fscanf(results, "%lld %d %lld %lld %lld %lf", &index, &solvable, &guesses, &before, &safe, &odds) == 6;
+					match = match && index == b && before == stall[b] && solvable == (stall[b] == safe) && odds > 0. && odds <= 1.;
+				}
+				match = match && read == count;
+			}
+			
+			// every thread count gives the same summary
+			agree = agree && read == count && analysis.solvable == first.solvable && analysis.guesses == first.guesses && analysis.progress == first.progress && analysis.odds == first.odds;
+			analysisCleanup(&analysis);
+			fclose(results);
+		}
+		printf("  %.2f%% solvable without guessing, %.3f guesses per board, %.2f%% opened before the first guess, %.2f%% chance every guess lands\n", 100. * first.solvable / first.boards, (double)first.guesses / first.boards, 100. * first.progress / first.boards, 100. * first.odds / first.oddsKnown);
+		printf("  progress %s the recount, threads %s\n", match ? "matches" : "DIFFERS FROM", agree ? "agree" : "DISAGREE");
+		fclose(boards);
+		free(stall);
+		gameBoardCleanup(&game);
+		solverCleanup(&solver);
+		probabilityCleanup(&probability);
+	}
+}
+
+int main(int argc, char **argv){
+	BenchSuite suites[] = {
+		{ "packed", benchPacked },
+		{ "count", benchCount },
+		{ "placement", benchPlacement },
+		{ "random", benchRandom },
+		{ "batch", benchBatch },
+		{ "padded", benchPadded },
+		{ "reveal", benchReveal },
+		{ "parallel", benchParallel },
+		{ "regions", benchRegions },
+		{ "relocate", benchRelocate },
+		{ "edits", benchEdits },
+		{ "world", benchWorld },
+		{ "session", benchSession },
+		{ "index", benchIndex },
+		{ "arena", benchArena },
+		{ "clear", benchClear },
+		{ "dirty", benchDirty },
+		{ "solver", benchSolver },
+		{ "probability", benchProbability },
+		{ "frontier", benchFrontier },
+		{ "noguess", benchNoGuess },
+		{ "analysis", benchAnalysis }
+	};
+	int suiteTotal = sizeof(suites) / sizeof(BenchSuite);
+	
+	// run every suite, or only those named on the command line
+	for(int s = 0; s < suiteTotal; s++){
+		int run = argc < 2;
+		for(int a = 1; a < argc; a++)
+			if(strcmp(argv[a], suites[s].name) == 0)
+				run = 1;
+		if(!run) continue;
+		printf("== %s ==\n", suites[s].name);
+		suites[s].run();
+	}
+	
+	return 0;
+}
@@ -0,0 +1,1270 @@
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#include "board.h"
+
+// setup functions
+
+int gameBoardSetup(Game *game, int width, int height, int64_t mines){
+	game->width = width;
+	game->height = height;
+	game->mines = mines;
+	game->cell = NULL;
+	game->countRow = NULL;
+	game->revealQueue = NULL;
+	game->spanStack = NULL;
+	game->spanCapacity = 0;
+	game->blockEpoch = NULL;
+	game->dirty = NULL;
+	game->allocations = 0;
+	arenaSetup(&game->arena);
+	game->prepared = 0;
+	game->labelRegions = 0;
+	game->labelled = 0;
+	game->region = NULL;
+	game->regionStart = NULL;
+	game->regionRun = NULL;
+	game->regionBlocked = NULL;
+	game->trackFrontier = 0;
+	game->frontierStale = game->frontierAll = 1;
+	game->changed = game->frontier = game->touched = NULL;
+	game->frontierMark = NULL;
+	game->frontierMarkTiles = 0;
+	game->changedTotal = game->changedCapacity = 0;
+	game->frontierTotal = game->frontierLive = game->frontierCapacity = 0;
+	game->touchedTotal = game->touchedCapacity = 0;
+	game->threads = gameCpuCount();
+	game->revealHandoff = REVEAL_HANDOFF_TILES;
+	game->revealPool = NULL;
+	game->generate = NULL;
+	game->generator = NULL;
+	game->random.next = randomXoshiro;
+	gameSeed(game, (uint64_t)time(NULL) ^ (uint64_t)(uintptr_t)game);
+	if(gameResize(game))
+		return -1;
+	gameClear(game);
+	return 0;
+}
+
+int gameViewSetup(Game *game, int width, int height, int64_t mines){ // a Game over cells the caller points cell at, every field zeroed and only the count row and block stamps owned; masks all read as they are stored
+	memset(game, 0, sizeof(Game));
+	game->width = width;
+	game->height = height;
+	game->mines = mines;
+	game->totalTiles = (int64_t)width * height;
+	game->blockTotal = (game->totalTiles + (1 << CELL_BLOCK_SHIFT) - 1) >> CELL_BLOCK_SHIFT;
+	arenaSetup(&game->arena);
+	size_t epochSize = sizeof(unsigned int) * game->blockTotal;
+	size_t rowSize = sizeof(unsigned char) * (width + 2) * 2;
+	int grown = arenaReserve(&game->arena, arenaSize(epochSize) + arenaSize(rowSize));
+	if(grown < 0)
+		return -1;
+	game->allocations = grown;
+	game->blockEpoch = arenaTake(&game->arena, epochSize);
+	game->countRow = arenaTake(&game->arena, rowSize);
+	memset(game->blockEpoch, 0, epochSize); // stamped with epoch 0, so every block is current
+	memset(game->countRow, 0, rowSize);
+	game->dirtyAll = 1; // nothing is drawn, so no tile is listed
+	game->frontierStale = game->frontierAll = 1;
+	game->threads = 1;
+	game->revealHandoff = REVEAL_HANDOFF_TILES;
+	game->random.next = randomXoshiro;
+	return 0;
+}
+
+void gameSeed(Game *game, uint64_t seed){
+	randomSeed(&game->random, seed);
+}
+
+void gameClear(Game *game){
+	
+	// constant time: every block's stamp falls behind, so its masks read as hidden until first written
+	game->epoch++;
+	if(game->epoch == 0){ // wrapped, restamp so that no block looks current
+		memset(game->blockEpoch, 0, sizeof(unsigned int) * game->blockTotal);
+		game->epoch = 1;
+	}
+	game->dirtyAll = 1;
+	game->frontierStale = 1;
+	game->labelled = 0;
+	game->prepared = 0;
+	game->state = 0;
+}
+
+void gameSettle(Game *game){ // brings every block up to date, for code reading cell bytes directly
+	for(int64_t b = 0; b < game->blockTotal; b++)
+		if(game->blockEpoch[b] != game->epoch)
+			gameBlockRefresh(game, b);
+}
+
+void gamePrepare(Game *game){
+	for(int64_t t = 0; t < game->totalTiles; t++)
+		gameSetTile(game, t, 0);
+	gamePlaceMines(game, -1);
+	gameCountMines(game);
+	game->dirtyAll = 1;
+	game->frontierStale = 1;
+	game->prepared = 1;
+}
+
+void gameStart(Game *game, int64_t startTile){
+	
+	// reset board
+	for(int64_t t = 0; t < game->totalTiles; t++)
+		gameSetTile(game, t, 0);
+	
+	// place mines
+	game->freeSpace = game->totalTiles - game->mines;
+	gamePlaceMines(game, startTile);
+	
+	// count mines
+	gameCountMines(game);
+	if(game->labelRegions)
+		gameLabelRegions(game);
+	
+	// set play state
+	game->dirtyAll = 1;
+	game->frontierStale = 1;
+	game->prepared = 0;
+	game->state = 1;
+}
+
+void gameRelocate(Game *game, int64_t startTile){
+	int64_t safezone[9];
+	gameGetConnectedTiles(startTile, game, (int64_t*)&safezone);
+	safezone[8] = startTile;
+	int64_t zone[9];
+	int zoneSize = 0;
+	for(int z = 0; z < 9; z++){
+		if(safezone[z] < 0) continue;
+		int i;
+		for(i = zoneSize; i > 0 && zone[i - 1] > safezone[z]; i--)
+			zone[i] = zone[i - 1];
+		zone[i] = safezone[z];
+		zoneSize++;
+	}
+	int64_t eligible = game->totalTiles - zoneSize;
+	
+	// too dense to clear the whole safezone: generate as gameStart does
+	int zoneMines = 0;
+	for(int z = 0; z < zoneSize; z++)
+		zoneMines += gameTile(game, zone[z]) == -1;
+	if(game->mines > eligible){
+		gameStart(game, startTile);
+		return;
+	}
+	
+	// move each safezone mine to a random free tile outside it, giving up on boards too full to find one quickly
+	for(int m = 0; m < zoneMines; m++){
+		int64_t target = -1;
+		for(int attempt = 0; attempt < RELOCATE_ATTEMPTS && target < 0; attempt++){
+			int64_t tile = gameEligibleTile(randomBelow64(&game->random, eligible), zone, zoneSize);
+			if(gameTile(game, tile) != -1)
+				target = tile;
+		}
+		if(target < 0){
+			game->mines -= m; // mines added so far are discarded by the regeneration
+			gameStart(game, startTile);
+			return;
+		}
+		gameMineAdd(game, target);
+	}
+	for(int z = 0; z < zoneSize; z++)
+		if(gameTile(game, zone[z]) == -1)
+			gameMineRemove(game, zone[z]);
+	
+	game->freeSpace = game->totalTiles - game->mines;
+	if(game->labelRegions)
+		gameLabelRegions(game);
+	game->prepared = 0;
+	game->state = 1;
+}
+
+int gameResize(Game *game){
+	free(game->region);
+	game->region = NULL;
+	game->labelled = 0;
+	game->changedTotal = 0; // the frontier arrays are kept, and only grown by the next build
+	game->frontierStale = 1;
+	game->totalTiles = (int64_t)game->width * game->height;
+	game->blockTotal = (game->totalTiles + (1 << CELL_BLOCK_SHIFT) - 1) >> CELL_BLOCK_SHIFT;
+	game->cell = game->countRow = NULL;
+	game->blockEpoch = NULL;
+	game->dirty = NULL;
+	game->revealQueue = NULL;
+	
+	// board arrays carved from the arena, which only reallocates to grow
+	size_t cellSize = sizeof(unsigned char) * game->totalTiles;
+	size_t epochSize = sizeof(unsigned int) * game->blockTotal;
+	game->dirtyCapacity = game->totalTiles / 8 + 64 < GAME_DIRTY_LIMIT ? game->totalTiles / 8 + 64 : GAME_DIRTY_LIMIT;
+	size_t dirtySize = sizeof(int64_t) * game->dirtyCapacity;
+	size_t rowSize = sizeof(unsigned char) * (game->width + 2) * 2;
+	size_t queueSize = sizeof(int64_t) * game->totalTiles;
+	int grown = arenaReserve(&game->arena, arenaSize(cellSize) + arenaSize(epochSize) + arenaSize(dirtySize) + arenaSize(rowSize) + arenaSize(queueSize));
+	if(grown < 0)
+		return -1;
+	game->allocations += grown;
+	arenaReset(&game->arena);
+	game->cell = arenaTake(&game->arena, cellSize);
+	game->blockEpoch = arenaTake(&game->arena, epochSize);
+	game->dirty = arenaTake(&game->arena, dirtySize);
+	game->countRow = arenaTake(&game->arena, rowSize);
+	game->revealQueue = arenaTake(&game->arena, queueSize);
+	memset(game->countRow, 0, rowSize);
+	
+	// every block stale, so the new board reads as hidden
+	memset(game->blockEpoch, 0, epochSize);
+	game->epoch = 1;
+	game->dirtyTotal = 0;
+	game->dirtyAll = 1;
+	
+	// the span stack is regrown by fills, so it stays a separate allocation and only grows here
+	int spanCapacity = game->width + game->height + 16;
+	if(game->spanCapacity < spanCapacity){
+		int64_t *spanStack = realloc(game->spanStack, sizeof(int64_t) * 2 * spanCapacity);
+		if(spanStack == NULL)
+			return -1;
+		game->spanStack = spanStack;
+		game->spanCapacity = spanCapacity;
+		game->allocations++;
+	}
+	return 0;
+}
+
+// move functions
+
+void gameSelect(Game *game, int64_t target){
+	if(game->state == 0 && game->generate != NULL && game->generate(game, target) == 0)
+		; // started on a board from the generation hook
+	else if(game->state == 0 && game->prepared) // start game on the prepared board
+		gameRelocate(game, target);
+	else if(game->state == 0) // start game
+		gameStart(game, target);
+	
+	if(gameMask(game, target) == 1){ // reveal tile
+		gameTileReveal(target, game);
+		
+		if(gameTile(game, target) == -1){ // game lost
+			game->state = 2;
+			gameShowBombs(game);
+		}
+		
+		else if(game->freeSpace <= 0) // game won
+			game->state = 3;
+	}
+}
+
+void gameFlag(Game *game, int64_t target){
+	int mask = gameMask(game, target);
+	if(mask != 1 && mask != 2) return;
+	gameSetMask(game, target, mask == 1 ? 2 : 1);
+	
+	// a flag inside an unopened region stops its precomputed reveal being exact
+	if(game->labelled && gameTile(game, target) == 0 && game->regionBlocked[game->region[target]] >= 0)
+		game->regionBlocked[game->region[target]] += mask == 1 ? 1 : -1;
+	
+	if(mask == 2) // deductions may have leant on the flag
+		game->frontierAll = 1;
+	if(game->trackFrontier)
+		gameFrontierUpdate(game);
+}
+
+// game operation functions
+
+void gameBlockRefresh(Game *game, int64_t block){ // hides the tiles of a block left from before gameClear
+	int64_t first = block << CELL_BLOCK_SHIFT;
+	int64_t last = first + (1 << CELL_BLOCK_SHIFT) < game->totalTiles ? first + (1 << CELL_BLOCK_SHIFT) : game->totalTiles;
+	for(int64_t i = first; i < last; i++)
+		game->cell[i] = (game->cell[i] & CELL_TILE) | (1 << CELL_MASK_SHIFT);
+	game->blockEpoch[block] = game->epoch;
+}
+
+void gameDirtyReset(Game *game){ // called once the changed tiles have been redrawn
+	game->dirtyTotal = 0;
+	game->dirtyAll = 0;
+}
+
+void gameTileCheck(int64_t target, int64_t *queueSize, Game *game){
+	if(gameMask(game, target) == 1){
+		game->revealQueue[*queueSize] = target;
+		*queueSize += 1;
+		gameSetMask(game, target, 0);
+	}
+}
+
+void gameTileReveal(int64_t target, Game *game){
+	int label = game->labelled && gameTile(game, target) == 0 ? game->region[target] : -1;
+	if(label >= 0 && game->regionBlocked[label] == 0)
+		gameTileRevealRegion(target, game);
+	else if(game->totalTiles >= REVEAL_PARALLEL_TILES && game->threads > 1)
+		gameTileRevealParallel(target, game, game->threads);
+	else
+		gameTileRevealSpan(target, game);
+	if(label >= 0) // opened, later clicks in the region fill as usual
+		game->regionBlocked[label] = -1;
+	if(game->trackFrontier)
+		gameFrontierUpdate(game);
+}
+
+void gameTileRevealRegion(int64_t target, Game *game){
+	int label = game->region[target];
+	int spaceFreed = 0;
+	for(int r = game->regionStart[label]; r < game->regionStart[label + 1]; r++){
+		for(int i = game->regionRun[r * 2]; i <= game->regionRun[r * 2 + 1]; i++){
+			if(gameMask(game, i) == 1){
+				gameSetMask(game, i, 0);
+				spaceFreed++;
+			}
+		}
+	}
+	game->freeSpace -= spaceFreed;
+}
+
+void gameTileRevealQueue(int64_t target, Game *game){
+	gameSetMask(game, target, 0);
+	game->revealQueue[0] = target;
+	game->freeSpace -= gameTileFlood(game, 1);
+}
+
+int64_t gameTileFlood(Game *game, int64_t queueSize){
+	int64_t *reveal = game->revealQueue;
+	
+	int64_t spaceFreed;
+	for(spaceFreed = 0; spaceFreed < queueSize; spaceFreed++){
+		if(gameTile(game, reveal[spaceFreed]) == 0){
+			int64_t pos[8];
+			gameGetConnectedTiles(reveal[spaceFreed], game, (int64_t*)&pos);
+			for(int i = 0; i < 8; i++){
+				if(pos[i] >= 0)
+					gameTileCheck(pos[i], &queueSize, game);
+			}
+		}
+	}
+	return spaceFreed;
+}
+
+void gameTileRevealSpan(int64_t target, Game *game){
+	
+	// the whole board as one band, overflowing into the reveal queue
+	RevealBand band;
+	band.rowFirst = 0;
+	band.rowLast = game->height - 1;
+	band.stack = game->spanStack;
+	band.capacity = game->spanCapacity;
+	band.pending = 0;
+	band.overflow = game->revealQueue;
+	band.overflowTotal = 0;
+	band.limit = INT64_MAX;
+	band.threaded = 0;
+	
+	gameSetMask(game, target, 0);
+	band.spaceFreed = 1;
+	if(gameTile(game, target) == 0)
+		gameBandPush(&band, target, target);
+	gameBandFill(game, &band);
+	game->spanStack = band.stack;
+	game->spanCapacity = band.capacity;
+	if(band.overflowTotal > 0)
+		band.spaceFreed += gameTileFlood(game, band.overflowTotal) - band.overflowTotal;
+	game->freeSpace -= band.spaceFreed;
+}
+
+void gameTileRevealParallel(int64_t target, Game *game, int threads){
+	
+	// only empty tiles open regions worth splitting
+	if(gameTile(game, target) != 0 || threads < 2 || game->height < 2){
+		gameTileRevealSpan(target, game);
+		return;
+	}
+	
+	// most clicks open little, so the fill starts on the calling thread as gameTileRevealSpan and only hands off past revealHandoff tiles
+	RevealBand span;
+	span.rowFirst = 0;
+	span.rowLast = game->height - 1;
+	span.stack = game->spanStack;
+	span.capacity = game->spanCapacity;
+	span.pending = 0;
+	span.overflow = game->revealQueue;
+	span.overflowTotal = 0;
+	span.limit = game->revealHandoff;
+	span.threaded = 0;
+	gameSetMask(game, target, 0);
+	span.spaceFreed = 1;
+	gameBandPush(&span, target, target);
+	gameBandFill(game, &span);
+	RevealPool *pool = NULL;
+	if(span.pending > 0 && span.overflowTotal == 0)
+		pool = gameRevealPool(game, threads);
+	if(pool == NULL){
+		span.limit = INT64_MAX;
+		gameBandFill(game, &span);
+	}
+	game->spanStack = span.stack;
+	game->spanCapacity = span.capacity;
+	if(pool == NULL){
+		if(span.overflowTotal > 0)
+			span.spaceFreed += gameTileFlood(game, span.overflowTotal) - span.overflowTotal;
+		game->freeSpace -= span.spaceFreed;
+		return;
+	}
+	
+	// a block shared by two bands holds the first tile of the later one, brought up to date here so no two threads refresh it
+	RevealBand *band = pool->band;
+	for(int k = 0; k < pool->bandTotal; k++){
+		int64_t block = ((int64_t)band[k].rowFirst * game->width) >> CELL_BLOCK_SHIFT;
+		if(game->blockEpoch[block] != game->epoch)
+			gameBlockRefresh(game, block);
+		band[k].pending = 0;
+		band[k].overflow = game->revealQueue + (int64_t)band[k].rowFirst * game->width;
+		band[k].overflowTotal = 0;
+		band[k].edgeTotal[0][0] = band[k].edgeTotal[0][1] = band[k].edgeTotal[1][0] = band[k].edgeTotal[1][1] = 0;
+		band[k].spaceFreed = 0;
+		band[k].dirtyTotal = 0;
+		band[k].dirtyFull = 0;
+	}
+	
+	// the runs still pending go to the bands holding their rows
+	for(int r = 0; r < span.pending; r++){
+		int64_t a = span.stack[r * 2], b = span.stack[r * 2 + 1];
+		gameBandPush(&band[gameBandOf(a, game->width, band)], a, b);
+	}
+	
+	// run every band to a standstill, then hand the runs that crossed band edges to their neighbours
+	for(pool->round = 0; ; pool->round++){
+		int parity = pool->round & 1;
+		int active = 0;
+		for(int k = 0; k < pool->bandTotal; k++){
+			band[k].edgeTotal[parity][0] = band[k].edgeTotal[parity][1] = 0;
+			active |= band[k].pending > 0;
+			active |= pool->round > 0 && (
+				(k > 0 && band[k - 1].edgeTotal[parity ^ 1][1] > 0) || 
+				(k < pool->bandTotal - 1 && band[k + 1].edgeTotal[parity ^ 1][0] > 0));
+		}
+		if(!active) break;
+		pool->parity = parity;
+		gameRevealRound(pool);
+	}
+	
+	// the bands' opened tiles join the dirty and changed lists, overflowing as gameMarkDirty would; then the tiles that overflowed any band's stack are flooded
+	int64_t spaceFreed = span.spaceFreed;
+	int64_t overflowTotal = 0;
+	for(int k = 0; k < pool->bandTotal; k++){
+		if(band[k].dirtyFull){
+			game->dirtyAll = 1;
+			game->frontierStale = 1;
+		}
+		else{
+			for(int64_t d = 0; d < band[k].dirtyTotal; d++)
+				gameMarkDirty(game, band[k].dirty[d]);
+		}
+		memmove(game->revealQueue + overflowTotal, band[k].overflow, sizeof(int64_t) * band[k].overflowTotal);
+		overflowTotal += band[k].overflowTotal;
+		spaceFreed += band[k].spaceFreed;
+	}
+	if(overflowTotal > 0)
+		spaceFreed += gameTileFlood(game, overflowTotal) - overflowTotal;
+	game->freeSpace -= spaceFreed;
+}
+
+RevealPool *gameRevealPool(Game *game, int threads){ // the Game's bands for this board and thread count, set up again only when either changed; NULL on failure
+	int bandTotal = threads < game->height ? threads : game->height;
+	RevealPool *pool = game->revealPool;
+	if(pool != NULL && pool->bandTotal != bandTotal){
+		gameRevealPoolCleanup(pool);
+		free(pool);
+		pool = game->revealPool = NULL;
+	}
+	
+	// the bands and their threads, which then wait for rounds
+	if(pool == NULL){
+		pool = calloc(1, sizeof(RevealPool));
+		if(pool == NULL)
+			return NULL;
+		pool->game = game;
+		pool->bandTotal = bandTotal;
+		pool->band = calloc(bandTotal, sizeof(RevealBand));
+		pool->worker = malloc(sizeof(pthread_t) * bandTotal);
+		pool->work = malloc(sizeof(RevealWork) * bandTotal);
+		if(pool->band == NULL || pool->worker == NULL || pool->work == NULL || pthread_mutex_init(&pool->lock, NULL)){
+			free(pool->band);
+			free(pool->worker);
+			free(pool->work);
+			free(pool);
+			return NULL;
+		}
+		pthread_cond_init(&pool->wake, NULL);
+		pthread_cond_init(&pool->idle, NULL);
+		for(int k = 0; k < bandTotal; k++){
+			pool->band[k].limit = INT64_MAX;
+			pool->band[k].threaded = 1;
+		}
+		game->revealPool = pool;
+		for(; pool->workerTotal < bandTotal - 1; pool->workerTotal++){ // bands without a thread run on the calling one
+			RevealWork *work = &pool->work[pool->workerTotal];
+			work->pool = pool;
+			work->index = pool->workerTotal + 1;
+			work->seen = 0;
+			if(pthread_create(&pool->worker[pool->workerTotal], NULL, gameBandWorker, work))
+				break;
+		}
+	}
+	
+	// rows split for this height, edge lists and stacks sized for this width
+	RevealBand *band = pool->band;
+	for(int k = 0; k < bandTotal; k++){
+		band[k].rowFirst = game->height * k / bandTotal;
+		band[k].rowLast = game->height * (k + 1) / bandTotal - 1;
+		band[k].pending = 0;
+		if(band[k].capacity < game->width + 16){
+			int64_t *stack = realloc(band[k].stack, sizeof(int64_t) * 2 * (game->width + 16));
+			if(stack == NULL)
+				return NULL;
+			band[k].stack = stack;
+			band[k].capacity = game->width + 16;
+		}
+		if(pool->width < game->width){
+			for(int e = 0; e < 4; e++){
+				int64_t *edge = realloc(band[k].edge[e / 2][e % 2], sizeof(int64_t) * 2 * game->width);
+				if(edge == NULL)
+					return NULL;
+				band[k].edge[e / 2][e % 2] = edge;
+			}
+		}
+	}
+	pool->width = pool->width > game->width ? pool->width : game->width;
+	return pool;
+}
+
+void gameRevealRound(RevealPool *pool){ // one round on every band, returning once all have stopped
+	pthread_mutex_lock(&pool->lock);
+	pool->busy = pool->workerTotal;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->wake);
+	pthread_mutex_unlock(&pool->lock);
+	gameBandRound(pool, 0);
+	for(int k = pool->workerTotal + 1; k < pool->bandTotal; k++)
+		gameBandRound(pool, k);
+	pthread_mutex_lock(&pool->lock);
+	while(pool->busy > 0)
+		pthread_cond_wait(&pool->idle, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+}
+
+void *gameBandWorker(void *data){
+	RevealWork *work = data;
+	RevealPool *pool = work->pool;
+	pthread_mutex_lock(&pool->lock);
+	while(1){
+		while(pool->generation == work->seen && !pool->stop)
+			pthread_cond_wait(&pool->wake, &pool->lock);
+		if(pool->stop)
+			break;
+		work->seen = pool->generation;
+		pthread_mutex_unlock(&pool->lock);
+		gameBandRound(pool, work->index);
+		pthread_mutex_lock(&pool->lock);
+		if(--pool->busy == 0)
+			pthread_cond_signal(&pool->idle);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return NULL;
+}
+
+void gameBandRound(RevealPool *pool, int k){
+	Game *game = pool->game;
+	RevealBand *band = &pool->band[k];
+	int previous = pool->parity ^ 1;
+	
+	// reveal the runs neighbouring bands found in this band's edge rows last round
+	if(pool->round > 0){
+		if(k > 0){
+			RevealBand *above = &pool->band[k - 1];
+			for(int e = 0; e < above->edgeTotal[previous][1]; e++)
+				gameBandReveal(game, band, above->edge[previous][1][e * 2], above->edge[previous][1][e * 2 + 1]);
+		}
+		if(k < pool->bandTotal - 1){
+			RevealBand *below = &pool->band[k + 1];
+			for(int e = 0; e < below->edgeTotal[previous][0]; e++)
+				gameBandReveal(game, band, below->edge[previous][0][e * 2], below->edge[previous][0][e * 2 + 1]);
+		}
+	}
+	band->parity = pool->parity;
+	gameBandFill(game, band);
+}
+
+void gameBandFill(Game *game, RevealBand *band){
+	
+	// each span is a run of revealed empty tiles in one row whose neighbours are still to be revealed
+	while(band->pending > 0 && band->spaceFreed < band->limit){
+		band->pending--;
+		int64_t a = band->stack[band->pending * 2];
+		int64_t b = band->stack[band->pending * 2 + 1];
+		int y = gameRow(game, a);
+		int64_t rowStart = (int64_t)y * game->width;
+		int64_t rowEnd = rowStart + game->width - 1;
+		
+		// extend the span along its row, stopping after the first numbered tile on each side
+		while(a > rowStart && gameMask(game, a - 1) == 1){
+			gameBandOpen(game, band, a - 1);
+			band->spaceFreed++;
+			if(gameTile(game, a - 1) != 0) break;
+			a--;
+		}
+		while(b < rowEnd && gameMask(game, b + 1) == 1){
+			gameBandOpen(game, band, b + 1);
+			band->spaceFreed++;
+			if(gameTile(game, b + 1) != 0) break;
+			b++;
+		}
+		
+		// reveal the rows above and below, or pass them to the neighbouring band past an edge
+		int64_t lo = a > rowStart ? a - 1 : a;
+		int64_t hi = b < rowEnd ? b + 1 : b;
+		for(int side = 0; side < 2; side++){
+			int row = side == 0 ? y - 1 : y + 1;
+			int64_t d = side == 0 ? -game->width : game->width;
+			if(row < 0 || row >= game->height) continue;
+			if(row >= band->rowFirst && row <= band->rowLast)
+				gameBandReveal(game, band, lo + d, hi + d);
+			else{
+				int64_t *edge = band->edge[band->parity][side];
+				edge[band->edgeTotal[band->parity][side] * 2] = lo + d;
+				edge[band->edgeTotal[band->parity][side] * 2 + 1] = hi + d;
+				band->edgeTotal[band->parity][side]++;
+			}
+		}
+	}
+}
+
+void gameBandReveal(Game *game, RevealBand *band, int64_t first, int64_t last){
+	int64_t runStart = -1;
+	for(int64_t i = first; i <= last; i++){
+		int empty = 0;
+		if(gameMask(game, i) == 1){
+			gameBandOpen(game, band, i);
+			band->spaceFreed++;
+			empty = gameTile(game, i) == 0;
+		}
+		if(empty && runStart < 0)
+			runStart = i;
+		else if(!empty && runStart >= 0){
+			gameBandPush(band, runStart, i - 1);
+			runStart = -1;
+		}
+	}
+	if(runStart >= 0)
+		gameBandPush(band, runStart, last);
+}
+
+void gameBandPush(RevealBand *band, int64_t a, int64_t b){
+	if(band->pending == band->capacity){
+		int64_t *grown = realloc(band->stack, sizeof(int64_t) * 2 * band->capacity * 2);
+		
+		// out of memory: leave the run's tiles for gameTileFlood once the fill is over
+		if(grown == NULL){
+			for(int64_t i = a; i <= b; i++)
+				band->overflow[band->overflowTotal++] = i;
+			return;
+		}
+		band->stack = grown;
+		band->capacity *= 2;
+	}
+	band->stack[band->pending * 2] = a;
+	band->stack[band->pending * 2 + 1] = b;
+	band->pending++;
+}
+
+void gameBandOpen(Game *game, RevealBand *band, int64_t i){ // reveals a tile, listing it in the band's own dirty list on a band thread
+	if(!band->threaded){
+		gameSetMask(game, i, 0);
+		return;
+	}
+	if(game->blockEpoch[i >> CELL_BLOCK_SHIFT] != game->epoch) // only blocks inside the band, the shared ones refreshed before the threads start
+		gameBlockRefresh(game, i >> CELL_BLOCK_SHIFT);
+	game->cell[i] &= CELL_TILE;
+	if(band->dirtyFull)
+		return;
+	if(band->dirtyTotal == band->dirtyCapacity){
+		int64_t capacity = band->dirtyCapacity * 2 > 1024 ? band->dirtyCapacity * 2 : 1024;
+		capacity = capacity < game->dirtyCapacity ? capacity : game->dirtyCapacity;
+		int64_t *dirty = capacity > band->dirtyCapacity ? realloc(band->dirty, sizeof(int64_t) * capacity) : NULL;
+		if(dirty == NULL){ // past what Game.dirty holds anyway, so the whole board is redrawn and the frontier rebuilt
+			band->dirtyFull = 1;
+			return;
+		}
+		band->dirty = dirty;
+		band->dirtyCapacity = capacity;
+	}
+	band->dirty[band->dirtyTotal++] = i;
+}
+
+int gameBandOf(int64_t target, int width, RevealBand *band){
+	int y = (int)(target / width);
+	int k = 0;
+	while(y > band[k].rowLast)
+		k++;
+	return k;
+}
+
+void gamePlaceMines(Game *game, int64_t startTile){ // a negative startTile places mines anywhere
+	int64_t safezone[9] = { -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+	if(startTile >= 0){
+		gameGetConnectedTiles(startTile, game, (int64_t*)&safezone);
+		safezone[8] = startTile;
+	}
+	int64_t bombs = 0;
+	int64_t freeSpace = game->totalTiles - game->mines;
+	
+	// place mines near starting tile upon necessity
+	int safeTiles = 0;
+	for(int z = 0; z < 8; z++)
+		safeTiles += safezone[z] != -1 ? 1 : 0;
+	if(freeSpace - safeTiles <= 0){
+		int safeAreaBombs = safeTiles - freeSpace + 1;
+		int shuffle[8] = { 0, 1, 2, 3, 4, 5, 6, 7 }; // Fisher-Yates shuffle
+		for(int i = 0; i < 7; i++){
+			int j = i + randomBelow(&game->random, 8 - i);
+			int t = shuffle[i];
+			shuffle[i] = shuffle[j];
+			shuffle[j] = t;
+		}
+		for(int b = 0; bombs < safeAreaBombs; b++){
+			if(safezone[shuffle[b]] >= 0){
+				gameSetTile(game, safezone[shuffle[b]], -1);
+				bombs++;
+			}
+		}
+	}
+	
+	// eligible tiles are every tile outside the safezone, numbered in board order by skipping the sorted safezone
+	int64_t zone[9];
+	int zoneSize = 0;
+	for(int z = 0; z < 9; z++){
+		if(safezone[z] < 0) continue;
+		int i;
+		for(i = zoneSize; i > 0 && zone[i - 1] > safezone[z]; i--)
+			zone[i] = zone[i - 1];
+		zone[i] = safezone[z];
+		zoneSize++;
+	}
+	int64_t eligible = game->totalTiles - zoneSize;
+	
+	// place other mines away from starting tile (Floyd's sampling: one draw per mine, a taken draw takes the newest index instead)
+	for(int64_t j = eligible - (game->mines - bombs); j < eligible; j++){
+		int64_t bombPos = gameEligibleTile(randomBelow64(&game->random, j + 1), zone, zoneSize);
+		if(gameTile(game, bombPos) == -1)
+			bombPos = gameEligibleTile(j, zone, zoneSize);
+		gameSetTile(game, bombPos, -1);
+	}
+}
+
+int64_t gameEligibleTile(int64_t index, int64_t *zone, int zoneSize){
+	for(int z = 0; z < zoneSize && zone[z] <= index; z++)
+		index++;
+	return index;
+}
+
+void gameCountMines(Game *game){
+	int width = game->width;
+	unsigned char *sum = game->countRow; // sum[x + 1]: mines in column x of the rows above, at and below the current row
+	unsigned char *zero = game->countRow + width + 2; // stands in for the rows beyond the board edge
+	for(int r = 0; r < game->height; r++){
+		unsigned char *row = game->cell + (int64_t)r * width;
+		unsigned char *above = r > 0 ? row - width : zero;
+		unsigned char *below = r < game->height - 1 ? row + width : zero;
+		int x;
+		
+		// column sums over three rows
+		x = 0;
+#if defined(__AVX2__)
+		__m256i tileBits = _mm256_set1_epi8(CELL_TILE);
+		for(; x + 32 <= width; x += 32){
+			__m256i a = _mm256_cmpeq_epi8(_mm256_and_si256(_mm256_loadu_si256((__m256i*)(above + x)), tileBits), tileBits);
+			__m256i b = _mm256_cmpeq_epi8(_mm256_and_si256(_mm256_loadu_si256((__m256i*)(row + x)), tileBits), tileBits);
+			__m256i c = _mm256_cmpeq_epi8(_mm256_and_si256(_mm256_loadu_si256((__m256i*)(below + x)), tileBits), tileBits);
+			__m256i column = _mm256_sub_epi8(_mm256_setzero_si256(), _mm256_add_epi8(_mm256_add_epi8(a, b), c));
+			_mm256_storeu_si256((__m256i*)(sum + x + 1), column);
+		}
+#elif defined(__SSE2__)
+		__m128i tileBits = _mm_set1_epi8(CELL_TILE);
+		for(; x + 16 <= width; x += 16){
+			__m128i a = _mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128((__m128i*)(above + x)), tileBits), tileBits);
+			__m128i b = _mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128((__m128i*)(row + x)), tileBits), tileBits);
+			__m128i c = _mm_cmpeq_epi8(_mm_and_si128(_mm_loadu_si128((__m128i*)(below + x)), tileBits), tileBits);
+			__m128i column = _mm_sub_epi8(_mm_setzero_si128(), _mm_add_epi8(_mm_add_epi8(a, b), c));
+			_mm_storeu_si128((__m128i*)(sum + x + 1), column);
+		}
+#endif
+		for(; x < width; x++)
+			sum[x + 1] = ((above[x] & CELL_TILE) == CELL_MINE) + ((row[x] & CELL_TILE) == CELL_MINE) + ((below[x] & CELL_TILE) == CELL_MINE);
+		
+		// neighbour counts from three neighbouring column sums, mines keep their marker
+		x = 0;
+#if defined(__AVX2__)
+		__m256i maskBits = _mm256_set1_epi8((char)~CELL_TILE);
+		for(; x + 32 <= width; x += 32){
+			__m256i cells = _mm256_loadu_si256((__m256i*)(row + x));
+			__m256i mine = _mm256_cmpeq_epi8(_mm256_and_si256(cells, tileBits), tileBits);
+			__m256i count = _mm256_add_epi8(_mm256_add_epi8(
+				_mm256_loadu_si256((__m256i*)(sum + x)), _mm256_loadu_si256((__m256i*)(sum + x + 1))), _mm256_loadu_si256((__m256i*)(sum + x + 2)));
+			count = _mm256_or_si256(_mm256_and_si256(mine, tileBits), _mm256_andnot_si256(mine, count));
+			_mm256_storeu_si256((__m256i*)(row + x), _mm256_or_si256(_mm256_and_si256(cells, maskBits), count));
+		}
+#elif defined(__SSE2__)
+		__m128i maskBits = _mm_set1_epi8((char)~CELL_TILE);
+		for(; x + 16 <= width; x += 16){
+			__m128i cells = _mm_loadu_si128((__m128i*)(row + x));
+			__m128i mine = _mm_cmpeq_epi8(_mm_and_si128(cells, tileBits), tileBits);
+			__m128i count = _mm_add_epi8(_mm_add_epi8(
+				_mm_loadu_si128((__m128i*)(sum + x)), _mm_loadu_si128((__m128i*)(sum + x + 1))), _mm_loadu_si128((__m128i*)(sum + x + 2)));
+			count = _mm_or_si128(_mm_and_si128(mine, tileBits), _mm_andnot_si128(mine, count));
+			_mm_storeu_si128((__m128i*)(row + x), _mm_or_si128(_mm_and_si128(cells, maskBits), count));
+		}
+#endif
+		for(; x < width; x++){
+			if((row[x] & CELL_TILE) != CELL_MINE)
+				row[x] = (row[x] & ~CELL_TILE) | (sum[x] + sum[x + 1] + sum[x + 2]);
+		}
+	}
+}
+
+int gameLabelRegions(Game *game){
+	int width = game->width;
+	game->labelled = 0;
+	if(game->totalTiles > GAME_FAST_TILES) // region runs and labels are 32-bit
+		return -1;
+	
+	// runs of empty tiles in each row
+	int runTotal = 0;
+	for(int i = 0; i < game->totalTiles; i++)
+		runTotal += gameTile(game, i) == 0 && (i % width == 0 || gameTile(game, i - 1) != 0);
+	int *run = malloc(sizeof(int) * 2 * (runTotal + 1));
+	int *parent = malloc(sizeof(int) * (runTotal + 1));
+	int *label = malloc(sizeof(int) * (runTotal + 1));
+	if(game->region == NULL)
+		game->region = malloc(sizeof(int) * game->totalTiles);
+	if(run == NULL || parent == NULL || label == NULL || game->region == NULL){
+		free(run);
+		free(parent);
+		free(label);
+		return -1;
+	}
+	
+	// join each run to the runs it touches in the row above, diagonals included, roots being the earliest run
+	int r = 0;
+	int previousFirst = 0;
+	for(int y = 0; y < game->height; y++){
+		int rowFirst = r;
+		int p = previousFirst;
+		for(int x = 0; x < width; x++){
+			if(gameTile(game, y * width + x) != 0) continue;
+			int a = x;
+			while(x + 1 < width && gameTile(game, y * width + x + 1) == 0)
+				x++;
+			run[r * 2] = y * width + a;
+			run[r * 2 + 1] = y * width + x;
+			parent[r] = r;
+			while(p < rowFirst && run[p * 2 + 1] - (y - 1) * width < a - 1)
+				p++;
+			for(int q = p; q < rowFirst && run[q * 2] - (y - 1) * width <= x + 1; q++){
+				int u = gameRegionRoot(parent, q), v = gameRegionRoot(parent, r);
+				if(u < v) parent[v] = u;
+				else parent[u] = v;
+			}
+			r++;
+		}
+		previousFirst = rowFirst;
+	}
+	
+	// number the regions and count the row runs covering each: the run and the rows above and below, one tile wider
+	game->regionTotal = 0;
+	for(r = 0; r < runTotal; r++){
+		int root = gameRegionRoot(parent, r);
+		label[r] = root == r ? game->regionTotal++ : label[root];
+	}
+	int *start = realloc(game->regionStart, sizeof(int) * (game->regionTotal + 1));
+	int *cover = realloc(game->regionRun, sizeof(int) * 2 * 3 * (runTotal + 1));
+	int *blocked = realloc(game->regionBlocked, sizeof(int) * (game->regionTotal + 1));
+	if(start != NULL) game->regionStart = start;
+	if(cover != NULL) game->regionRun = cover;
+	if(blocked != NULL) game->regionBlocked = blocked;
+	if(start == NULL || cover == NULL || blocked == NULL){
+		free(run);
+		free(parent);
+		free(label);
+		return -1;
+	}
+	for(int l = 0; l <= game->regionTotal; l++)
+		start[l] = blocked[l] = 0;
+	for(r = 0; r < runTotal; r++){
+		int y = run[r * 2] / width;
+		start[label[r] + 1] += 1 + (y > 0) + (y < game->height - 1);
+	}
+	for(int l = 0; l < game->regionTotal; l++)
+		start[l + 1] += start[l];
+	
+	// fill each region's cover runs, using parent as the per-region write position
+	for(int l = 0; l < game->regionTotal; l++)
+		parent[l] = start[l];
+	for(r = 0; r < runTotal; r++){
+		int y = run[r * 2] / width;
+		int lo = run[r * 2] % width > 0 ? run[r * 2] - 1 : run[r * 2];
+		int hi = run[r * 2 + 1] % width < width - 1 ? run[r * 2 + 1] + 1 : run[r * 2 + 1];
+		for(int d = -1; d <= 1; d++){
+			if(y + d < 0 || y + d >= game->height) continue;
+			int w = parent[label[r]]++;
+			cover[w * 2] = lo + d * width;
+			cover[w * 2 + 1] = hi + d * width;
+		}
+	}
+	
+	// sort and merge each region's runs so every tile is visited once
+	int merged = 0;
+	for(int l = 0; l < game->regionTotal; l++){
+		int first = start[l], last = start[l + 1];
+		qsort(cover + first * 2, last - first, sizeof(int) * 2, gameRegionRunOrder);
+		start[l] = merged;
+		for(int c = first; c < last; c++){
+			if(merged > start[l] && cover[c * 2] <= cover[merged * 2 - 1] + 1){
+				if(cover[c * 2 + 1] > cover[merged * 2 - 1])
+					cover[merged * 2 - 1] = cover[c * 2 + 1];
+			}
+			else{
+				cover[merged * 2] = cover[c * 2];
+				cover[merged * 2 + 1] = cover[c * 2 + 1];
+				merged++;
+			}
+		}
+	}
+	start[game->regionTotal] = merged;
+	
+	// region of each empty tile, counting empty tiles already flagged or open
+	memset(game->region, 0xFF, sizeof(int) * game->totalTiles);
+	for(r = 0; r < runTotal; r++){
+		for(int i = run[r * 2]; i <= run[r * 2 + 1]; i++){
+			game->region[i] = label[r];
+			blocked[label[r]] += gameMask(game, i) != 1;
+		}
+	}
+	
+	free(run);
+	free(parent);
+	free(label);
+	game->labelled = 1;
+	return 0;
+}
+
+int gameRegionRoot(int *parent, int r){
+	while(parent[r] != r){
+		parent[r] = parent[parent[r]];
+		r = parent[r];
+	}
+	return r;
+}
+
+int gameRegionRunOrder(const void *a, const void *b){
+	return *(const int*)a - *(const int*)b;
+}
+
+void gameShowBombs(Game *game){
+	int64_t i;
+	for(i = 0; i < game->totalTiles; i++)
+		if(gameMask(game, i) == 1 && gameTile(game, i) == -1)
+			gameSetMask(game, i, 0);
+}
+
+void gameGetConnectedTiles(int64_t target, Game *game, int64_t *pos){
+	int64_t width = game->width;
+	pos[0] = target - width - 1;
+	pos[1] = target - width;
+	pos[2] = target - width + 1;
+	pos[3] = target - 1;
+	pos[4] = target + 1;
+	pos[5] = target + width - 1;
+	pos[6] = target + width;
+	pos[7] = target + width + 1;
+	int y = gameRow(game, target);
+	int x = (int)(target - y * width);
+	if(y == 0)
+		pos[0] = pos[1] = pos[2] = -1;
+	if(y == game->height - 1)
+		pos[5] = pos[6] = pos[7] = -1;
+	if(x == 0)
+		pos[0] = pos[3] = pos[5] = -1;
+	if(x == game->width - 1)
+		pos[2] = pos[4] = pos[7] = -1;
+}
+
+// mine edit functions
+
+int gameMineAdd(Game *game, int64_t target){
+	if(gameTile(game, target) == -1)
+		return -1;
+	int64_t pos[8];
+	gameGetConnectedTiles(target, game, (int64_t*)&pos);
+	gameSetTile(game, target, -1);
+	for(int p = 0; p < 8; p++){
+		if(pos[p] >= 0 && gameTile(game, pos[p]) != -1){
+			gameSetTile(game, pos[p], gameTile(game, pos[p]) + 1);
+			if(gameMask(game, pos[p]) == 0){
+				gameMarkDirty(game, pos[p]);
+				game->frontierAll = 1;
+			}
+		}
+	}
+	game->mines++;
+	if(gameMask(game, target) != 0)
+		game->freeSpace--;
+	else
+		gameMarkDirty(game, target);
+	game->labelled = 0;
+	return 0;
+}
+
+int gameMineRemove(Game *game, int64_t target){
+	if(gameTile(game, target) != -1)
+		return -1;
+	int64_t pos[8];
+	gameGetConnectedTiles(target, game, (int64_t*)&pos);
+	int count = 0;
+	for(int p = 0; p < 8; p++){
+		if(pos[p] < 0) continue;
+		if(gameTile(game, pos[p]) == -1)
+			count++;
+		else{
+			gameSetTile(game, pos[p], gameTile(game, pos[p]) - 1);
+			if(gameMask(game, pos[p]) == 0){
+				gameMarkDirty(game, pos[p]);
+				game->frontierAll = 1;
+			}
+		}
+	}
+	gameSetTile(game, target, count);
+	game->mines--;
+	if(gameMask(game, target) != 0)
+		game->freeSpace++;
+	else
+		gameMarkDirty(game, target);
+	game->labelled = 0;
+	return 0;
+}
+
+int gameMineMove(Game *game, int64_t from, int64_t to){
+	if(gameTile(game, from) != -1 || gameTile(game, to) == -1)
+		return -1;
+	gameMineRemove(game, from);
+	gameMineAdd(game, to);
+	return 0;
+}
+
+int gameMineApply(Game *game, MineEdit *edit, int editTotal){
+	int applied = 0;
+	for(int e = 0; e < editTotal; e++){
+		int result;
+		if(edit[e].from < 0)
+			result = gameMineAdd(game, edit[e].to);
+		else if(edit[e].to < 0)
+			result = gameMineRemove(game, edit[e].from);
+		else
+			result = gameMineMove(game, edit[e].from, edit[e].to);
+		applied += result == 0;
+	}
+	return applied;
+}
+
+// frontier functions
+
+int gameFrontierUpdate(Game *game){ // applies the tiles changed since the last update, or rebuilds when they overflowed; -1 on allocation failure, leaving the frontier stale
+	if(game->frontierStale || game->frontierMark == NULL)
+		return gameFrontierBuild(game);
+	
+	// a changed tile may join or leave the frontier itself, and changes the hidden neighbours or count of those around it; a failure part way leaves it to a rebuild
+	for(int64_t c = 0; c < game->changedTotal; c++){
+		int64_t pos[8];
+		gameGetConnectedTiles(game->changed[c], game, (int64_t*)&pos);
+		if(gameFrontierCheck(game, game->changed[c])){
+			game->frontierStale = 1;
+			return -1;
+		}
+		for(int p = 0; p < 8; p++){
+			if(pos[p] >= 0 && gameFrontierCheck(game, pos[p])){
+				game->frontierStale = 1;
+				return -1;
+			}
+		}
+	}
+	game->changedTotal = 0;
+	if(game->frontierTotal > game->frontierLive * 2 + 64)
+		gameFrontierCompact(game);
+	return 0;
+}
+
+int gameFrontierBuild(Game *game){ // the frontier from the whole board, every constraint touched
+	game->frontierStale = 1;
+	
+	// the mark and change list outlive resizes, so only a larger board than any before calls the allocator
+	if(game->frontierMarkTiles < game->totalTiles){
+		unsigned char *mark = realloc(game->frontierMark, sizeof(unsigned char) * game->totalTiles);
+		if(mark == NULL)
+			return -1;
+		game->frontierMark = mark;
+		game->frontierMarkTiles = game->totalTiles;
+		game->allocations++;
+	}
+	int64_t capacity = game->totalTiles / 8 + 64 < GAME_DIRTY_LIMIT ? game->totalTiles / 8 + 64 : GAME_DIRTY_LIMIT;
+	if(game->changedCapacity < capacity){
+		int64_t *changed = realloc(game->changed, sizeof(int64_t) * capacity);
+		if(changed == NULL)
+			return -1;
+		game->changed = changed;
+		game->changedCapacity = capacity;
+		game->allocations++;
+	}
+	memset(game->frontierMark, 0, sizeof(unsigned char) * game->totalTiles);
+	game->frontierTotal = game->frontierLive = 0;
+	game->touchedTotal = 0;
+	for(int64_t t = 0; t < game->totalTiles; t++)
+		if(gameMask(game, t) == 0 && gameTile(game, t) > 0 && gameFrontierCheck(game, t))
+			return -1;
+	game->changedTotal = 0;
+	game->frontierStale = 0;
+	game->frontierAll = 1;
+	return 0;
+}
+
+int gameFrontierCheck(Game *game, int64_t target){ // brings a tile's frontier bits up to date, touching it while on the frontier
+	unsigned char *mark = &game->frontierMark[target];
+	int on = 0;
+	if(gameMask(game, target) == 0 && gameTile(game, target) > 0){
+		int64_t pos[8];
+		gameGetConnectedTiles(target, game, (int64_t*)&pos);
+		for(int p = 0; p < 8 && !on; p++)
+			on = pos[p] >= 0 && gameMask(game, pos[p]) == 1;
+	}
+	if(!on){
+		if(*mark & FRONTIER_ON){ // left, its entry dropped by the next compaction
+			*mark &= ~FRONTIER_ON;
+			game->frontierLive--;
+		}
+		return 0;
+	}
+	if(!(*mark & FRONTIER_ON)){
+		if(!(*mark & FRONTIER_LISTED)){
+			int grown = gameFrontierPush(&game->frontier, &game->frontierTotal, &game->frontierCapacity, target);
+			if(grown < 0)
+				return -1;
+			game->allocations += grown;
+			*mark |= FRONTIER_LISTED;
+		}
+		*mark |= FRONTIER_ON;
+		game->frontierLive++;
+	}
+	if(!(*mark & FRONTIER_TOUCHED)){
+		int grown = gameFrontierPush(&game->touched, &game->touchedTotal, &game->touchedCapacity, target);
+		if(grown < 0)
+			return -1;
+		game->allocations += grown;
+		*mark |= FRONTIER_TOUCHED;
+	}
+	return 0;
+}
+
+int gameFrontierPush(int64_t **list, int64_t *total, int64_t *capacity, int64_t target){ // appends, doubling the list when full; the allocator calls made, -1 on allocation failure
+	int grown = 0;
+	if(*total == *capacity){
+		int64_t size = *capacity * 2 > 1024 ? *capacity * 2 : 1024;
+		int64_t *resized = realloc(*list, sizeof(int64_t) * size);
+		if(resized == NULL)
+			return -1;
+		*list = resized;
+		*capacity = size;
+		grown = 1;
+	}
+	(*list)[(*total)++] = target;
+	return grown;
+}
+
+void gameFrontierCompact(Game *game){ // drops the entries of tiles that left the frontier
+	int64_t kept = 0;
+	for(int64_t f = 0; f < game->frontierTotal; f++){
+		int64_t t = game->frontier[f];
+		if(game->frontierMark[t] & FRONTIER_ON)
+			game->frontier[kept++] = t;
+		else
+			game->frontierMark[t] &= ~FRONTIER_LISTED;
+	}
+	game->frontierTotal = kept;
+}
+
+void gameTouchedReset(Game *game){ // called once the touched constraints have been re-solved
+	for(int64_t i = 0; i < game->touchedTotal; i++)
+		game->frontierMark[game->touched[i]] &= ~FRONTIER_TOUCHED;
+	game->touchedTotal = 0;
+	game->frontierAll = 0;
+}
+
+// thread functions
+
+int gameCpuCount(){
+#ifdef _WIN32
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (int)info.dwNumberOfProcessors;
+#else
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	return cpus > 0 ? (int)cpus : 1;
+#endif
+}
+
+// cleanup functions
+
+void gameBoardCleanup(Game *game){
+	arenaCleanup(&game->arena);
+	free(game->spanStack);
+	free(game->region);
+	free(game->regionStart);
+	free(game->regionRun);
+	free(game->regionBlocked);
+	free(game->changed);
+	free(game->frontierMark);
+	free(game->frontier);
+	free(game->touched);
+	if(game->revealPool != NULL){
+		gameRevealPoolCleanup(game->revealPool);
+		free(game->revealPool);
+		game->revealPool = NULL;
+	}
+}
+
+void gameRevealPoolCleanup(RevealPool *pool){ // stops and joins the workers, then frees the bands
+	pthread_mutex_lock(&pool->lock);
+	pool->stop = 1;
+	pthread_cond_broadcast(&pool->wake);
+	pthread_mutex_unlock(&pool->lock);
+	for(int w = 0; w < pool->workerTotal; w++)
+		pthread_join(pool->worker[w], NULL);
+	pthread_mutex_destroy(&pool->lock);
+	pthread_cond_destroy(&pool->wake);
+	pthread_cond_destroy(&pool->idle);
+	for(int k = 0; k < pool->bandTotal; k++){
+		free(pool->band[k].stack);
+		free(pool->band[k].dirty);
+		for(int e = 0; e < 4; e++)
+			free(pool->band[k].edge[e / 2][e % 2]);
+	}
+	free(pool->band);
+	free(pool->worker);
+	free(pool->work);
+}
@@ -0,0 +1,268 @@
+#ifndef BOARD
+#define BOARD
+
+#include <limits.h>
+#include <stdint.h>
+#include <pthread.h>
+
+#include "arena.h"
+#include "random.h"
+
+#define GAME_WIDTH 30
+#define GAME_HEIGHT 20
+#define GAME_MINES 99
+
+// packed cell layout: one byte per cell, neighbour count (or mine) in the low bits and mask state above
+#define CELL_TILE 0x0F
+#define CELL_MINE 0x0F
+#define CELL_MASK_SHIFT 4
+#define CELL_BLOCK_SHIFT 12 // tiles share a clear stamp in blocks of 1 << CELL_BLOCK_SHIFT
+
+#define RELOCATE_ATTEMPTS 64 // draws per safezone mine before gameRelocate regenerates the board instead
+
+#define REVEAL_PARALLEL_TILES 10000000 // boards from this size reveal with gameTileRevealParallel
+#define REVEAL_HANDOFF_TILES 65536 // default Game.revealHandoff
+
+#define GAME_FAST_TILES INT_MAX // boards up to this size take 32-bit index arithmetic and may label regions
+
+#define GAME_DIRTY_LIMIT (1 << 20) // most tiles listed as changed between redraws before every tile is redrawn instead
+
+// per-tile frontier bits
+#define FRONTIER_ON 0x01 // a revealed count with a hidden neighbour
+#define FRONTIER_LISTED 0x02 // has an entry in Game.frontier
+#define FRONTIER_TOUCHED 0x04 // listed in Game.touched
+
+typedef struct Vector{
+	float x;
+	float y;
+}Vector;
+
+typedef struct Game{
+	
+	// board settings
+	int width;
+	int height;
+	int64_t mines;
+	int64_t totalTiles; // tile indices are 64-bit throughout, so width * height may pass 2^31
+	
+	// current board
+	unsigned char *cell; // read and written through gameTile, gameMask, gameSetTile and gameSetMask
+	int64_t freeSpace;
+	unsigned int epoch; // advanced by gameClear, masks in blocks stamped with an older epoch read as hidden
+	unsigned int *blockEpoch; // stamp of each block of tiles, brought up to date on its first mask write
+	int64_t blockTotal;
+	int64_t *dirty; // tiles whose mask or shown count changed since gameDirtyReset, for redrawing only those
+	int64_t dirtyTotal;
+	int64_t dirtyCapacity;
+	int dirtyAll; // set when the whole board changed or the dirty list overflowed
+	
+	// menu
+	Vector *button;
+	Vector *buttonSize;
+	
+	// operational
+	Arena arena; // cell, blockEpoch, dirty, countRow and revealQueue, kept across resizes
+	int allocations; // allocator calls made by gameResize and frontier builds, none once the arena, span stack and frontier arrays fit every size used
+	Random random; // board generator, reseeded with gameSeed for reproducible boards
+	int64_t *revealQueue; // used to reveal nearby tiles upon clicking an empty tile
+	int64_t *spanStack; // first and last tile of each run of empty tiles still to be expanded by gameTileRevealSpan
+	int spanCapacity; // runs that fit in spanStack, grown on demand and never shrunk
+	unsigned char *countRow; // per-row mine sums used by gameCountMines, plus a row of zeros
+	int threads; // worker threads for revealing large boards, 1 to always reveal on the calling thread
+	int64_t revealHandoff; // tiles a parallel reveal opens on the calling thread before handing its runs to the bands
+	struct RevealPool *revealPool; // bands and worker threads of gameTileRevealParallel, started on first use and kept until gameBoardCleanup
+	int (*generate)(struct Game *game, int64_t startTile); // first-click generation in place of gameStart when set (e.g. noGuessStart), which stands in where it returns -1
+	void *generator; // state for generate, e.g. its NoGuess
+	
+	// empty regions, labelled at generation when labelRegions is set so that gameTileReveal can copy them open
+	int labelRegions;
+	int labelled;
+	int *region; // region of each empty tile, -1 for other tiles (boards up to GAME_FAST_TILES only)
+	int *regionStart; // first run of each region in regionRun, regionTotal + 1 entries
+	int *regionRun; // first and last tile of the runs covering each region's empty tiles and their neighbours
+	int *regionBlocked; // per region: empty tiles not hidden, or -1 once the region has been opened
+	int regionTotal;
+	
+	// constraint frontier, kept by gameTileReveal and gameFlag when trackFrontier is set
+	int trackFrontier;
+	int frontierStale; // the next gameFrontierUpdate rebuilds it from the whole board
+	int frontierAll; // every constraint counts as touched: rebuilt, or a flag or count taken back so earlier deductions may not hold
+	int64_t *changed; // tiles listed by gameMarkDirty since the last update, overflowing into frontierStale
+	int64_t changedTotal;
+	int64_t changedCapacity; // 0 until the frontier is first built, then grown by builds on larger boards and never shrunk
+	unsigned char *frontierMark; // FRONTIER_* bits of each tile
+	int64_t frontierMarkTiles; // tiles frontierMark holds, kept across resizes as changed
+	int64_t *frontier; // constraints, plus entries whose FRONTIER_ON bit has cleared until gameFrontierCompact drops them
+	int64_t frontierTotal;
+	int64_t frontierLive; // entries still on the frontier
+	int64_t frontierCapacity; // grown on demand and never shrunk, as touched
+	int64_t *touched; // constraints whose count, flags or hidden neighbours changed since gameTouchedReset
+	int64_t touchedTotal;
+	int64_t touchedCapacity;
+	
+	// game state
+	int prepared; // board generated ahead of the first click by gamePrepare
+	int state; // 0: started, awaiting tile generation on click, 1: game in progress, 2: game lost, 3: game won
+	int isPaused;
+}Game;
+
+// rows of the board filled by one thread of a reveal
+typedef struct RevealBand{
+	int rowFirst;
+	int rowLast;
+	int64_t *stack; // first and last tile of each run of revealed empty tiles still to be expanded
+	int capacity;
+	int pending;
+	int64_t *overflow; // empty tiles whose run did not fit in the stack, expanded by gameTileFlood afterwards
+	int64_t overflowTotal;
+	int64_t *edge[2][2]; // runs in the rows above [0] and below [1] the band for the neighbouring bands, double-buffered by round
+	int edgeTotal[2][2];
+	int parity;
+	int64_t spaceFreed;
+	int64_t limit; // spaceFreed at which gameBandFill stops with runs still pending
+	int threaded; // filled on a band thread: opened tiles go to the band's dirty list rather than Game.dirty
+	int64_t *dirty; // merged into Game.dirty and Game.changed after the join
+	int64_t dirtyTotal;
+	int64_t dirtyCapacity; // grown on demand up to Game.dirtyCapacity and never shrunk
+	int dirtyFull; // more tiles opened than Game.dirtyCapacity, or the list could not grow
+}RevealBand;
+
+// one edit for gameMineApply: from < 0 adds a mine at to, to < 0 removes the mine at from, otherwise moves it
+typedef struct MineEdit{
+	int64_t from;
+	int64_t to;
+}MineEdit;
+
+typedef struct RevealWork{
+	struct RevealPool *pool;
+	int index; // band run by the thread
+	unsigned seen; // last generation run
+}RevealWork;
+
+// bands of a parallel reveal and the threads filling them, each waiting between rounds rather than started for each
+typedef struct RevealPool{
+	Game *game;
+	RevealBand *band;
+	int bandTotal;
+	int width; // the edge lists fit rows this wide
+	pthread_t *worker; // worker w fills band w + 1, band 0 and any band without a worker filled on the calling thread
+	RevealWork *work;
+	int workerTotal;
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	pthread_cond_t idle;
+	unsigned generation; // advanced to start a round
+	int busy; // workers still in the round
+	int stop;
+	int round; // of the current reveal, 0 for the first
+	int parity;
+}RevealPool;
+
+// setup
+int gameBoardSetup(Game *game, int width, int height, int64_t mines);
+int gameViewSetup(Game *game, int width, int height, int64_t mines);
+void gameSeed(Game *game, uint64_t seed);
+void gameClear(Game *game);
+void gameSettle(Game *game);
+void gameStart(Game *game, int64_t startTile);
+void gamePrepare(Game *game);
+void gameRelocate(Game *game, int64_t startTile);
+int gameResize(Game *game);
+
+// moves
+void gameSelect(Game *game, int64_t target);
+void gameFlag(Game *game, int64_t target);
+
+// game operations
+void gameBlockRefresh(Game *game, int64_t block);
+void gameDirtyReset(Game *game);
+void gameTileCheck(int64_t target, int64_t *queueSize, Game *game);
+void gameTileReveal(int64_t target, Game *game);
+void gameTileRevealRegion(int64_t target, Game *game);
+void gameTileRevealQueue(int64_t target, Game *game);
+int64_t gameTileFlood(Game *game, int64_t queueSize);
+void gameTileRevealSpan(int64_t target, Game *game);
+void gameTileRevealParallel(int64_t target, Game *game, int threads);
+RevealPool *gameRevealPool(Game *game, int threads);
+void gameRevealRound(RevealPool *pool);
+void *gameBandWorker(void *data);
+void gameBandRound(RevealPool *pool, int k);
+void gameBandFill(Game *game, RevealBand *band);
+void gameBandReveal(Game *game, RevealBand *band, int64_t first, int64_t last);
+void gameBandPush(RevealBand *band, int64_t a, int64_t b);
+void gameBandOpen(Game *game, RevealBand *band, int64_t i);
+int gameBandOf(int64_t target, int width, RevealBand *band);
+void gamePlaceMines(Game *game, int64_t startTile);
+int64_t gameEligibleTile(int64_t index, int64_t *zone, int zoneSize);
+void gameCountMines(Game *game);
+int gameLabelRegions(Game *game);
+int gameRegionRoot(int *parent, int r);
+int gameRegionRunOrder(const void *a, const void *b);
+void gameShowBombs(Game *game);
+void gameGetConnectedTiles(int64_t target, Game *game, int64_t *pos);
+
+// mine edits (neighbour counts updated in place, -1 when the edit does not apply)
+int gameMineAdd(Game *game, int64_t target);
+int gameMineRemove(Game *game, int64_t target);
+int gameMineMove(Game *game, int64_t from, int64_t to);
+int gameMineApply(Game *game, MineEdit *edit, int editTotal);
+
+// threads
+int gameCpuCount();
+
+// frontier
+int gameFrontierUpdate(Game *game);
+int gameFrontierBuild(Game *game);
+int gameFrontierCheck(Game *game, int64_t target);
+int gameFrontierPush(int64_t **list, int64_t *total, int64_t *capacity, int64_t target);
+void gameFrontierCompact(Game *game);
+void gameTouchedReset(Game *game);
+
+// cleanup
+void gameBoardCleanup(Game *game);
+void gameRevealPoolCleanup(RevealPool *pool);
+
+// cell access (tile: -1 mine, 0-8 neighbouring mines; mask: 0 revealed, 1 hidden, 2 flagged)
+
+static inline int gameTile(Game *game, int64_t i){
+	int tile = game->cell[i] & CELL_TILE;
+	return tile == CELL_MINE ? -1 : tile;
+}
+
+static inline int gameMask(Game *game, int64_t i){
+	if(game->blockEpoch[i >> CELL_BLOCK_SHIFT] != game->epoch)
+		return 1;
+	return game->cell[i] >> CELL_MASK_SHIFT;
+}
+
+static inline void gameSetTile(Game *game, int64_t i, int tile){
+	game->cell[i] = (game->cell[i] & ~CELL_TILE) | (tile & CELL_TILE);
+}
+
+static inline void gameMarkDirty(Game *game, int64_t i){
+	if(game->dirtyTotal < game->dirtyCapacity)
+		game->dirty[game->dirtyTotal++] = i;
+	else if(!game->dirtyAll) // only read once set, so reveal threads never write it
+		game->dirtyAll = 1;
+	if(game->changedTotal < game->changedCapacity)
+		game->changed[game->changedTotal++] = i;
+	else if(!game->frontierStale) // as dirtyAll
+		game->frontierStale = 1;
+}
+
+static inline void gameSetMask(Game *game, int64_t i, int mask){
+	if(game->blockEpoch[i >> CELL_BLOCK_SHIFT] != game->epoch)
+		gameBlockRefresh(game, i >> CELL_BLOCK_SHIFT);
+	game->cell[i] = (game->cell[i] & CELL_TILE) | (mask << CELL_MASK_SHIFT);
+	gameMarkDirty(game, i);
+}
+
+// row of a tile, dividing in 32 bits on boards small enough for it
+
+static inline int gameRow(Game *game, int64_t i){
+	if(game->totalTiles <= GAME_FAST_TILES)
+		return (int)((uint32_t)i / (uint32_t)game->width);
+	return (int)(i / game->width);
+}
+
+#endif
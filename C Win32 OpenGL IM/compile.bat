@@ -1 +1 @@
-gcc -Wall -o minesweeper.exe main.c -lopengl32 -lGdi32
\ No newline at end of file
+gcc -Wall -pthread -o minesweeper.exe main.c board.c random.c arena.c -lopengl32 -lGdi32
\ No newline at end of file
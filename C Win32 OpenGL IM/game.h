@@ -2,7 +2,9 @@
 #define GAME
 
 #include <stdio.h>
-#include <time.h>
+#include <string.h>
+
+#include "board.h"
 
 #define TITLE_WIDTH .7f
 #define TITLE_HEIGHT .3f
@@ -10,15 +12,8 @@
 #define BUTTON_WIDTH .5f
 #define BUTTON_HEIGHT .1f
 #define BUTTON_GAP .3f
-
-#define GAME_WIDTH 30
-#define GAME_HEIGHT 20
-#define GAME_MINES 99
-
-typedef struct Vector{
-	float x;
-	float y;
-}Vector;
+#define DRAW_QUAD_TILES 10000 // boards from this size draw as one quad over a state texture, where the driver allows
+#define DRAW_VERTEX_TILES (1 << 28) // most tiles drawn from the vertex array, keeping its vertex count a GLsizei; larger boards need the state texture
 
 typedef struct Input{
 	int toggleMenu;
@@ -27,8 +22,18 @@ typedef struct Input{
 	Vector selectPos;
 }Input;
 
+// one corner of a tile's quad, interleaved as drawQuads reads them
+typedef struct TileVertex{
+	Vector uv;
+	Vector pos;
+}TileVertex;
+
 typedef struct DrawData{
 	
+	// storage
+	Arena arena; // every array below, carved by drawReserve
+	int allocations; // allocator calls made by drawReserve, none once the arena fits every board size used
+	
 	// window
 	Vector windowSize;
 	
@@ -41,10 +46,21 @@ typedef struct DrawData{
 	
 	// game board
 	Vector gameSize; // proportion of screen (gameSize x, y <= windowSize x, y)
-	int n;
-	Vector *tile;
+	int64_t n;
 	Vector tileSize;
-	int *value;
+	unsigned char *value; // draw value per tile, 0-11
+	TileVertex *vertex; // four corners per tile, positions set by drawScale and uvs by drawUpdate
+	
+	// single quad for large boards: draw values uploaded as a one-byte-per-tile texture, looked up per fragment
+	int quadTiles; // smallest board drawn this way, DRAW_QUAD_TILES unless changed before drawRetile
+	int quadBoard; // 1 when the current board is drawn as one quad instead of from vertex
+	unsigned int program; // board shader, 0 without shader support
+	int stateLimit; // largest texture side the driver takes
+	unsigned int stateTexture;
+	int boardWidth;
+	int boardHeight;
+	unsigned char *state; // draw value per tile as uploaded
+	unsigned char *rowDirty; // rows of state changed since the last upload
 	
 	// textures
 	unsigned int texture;
@@ -57,36 +73,8 @@ typedef struct DrawData{
 	Vector *tileUVHi;
 }DrawData;
 
-typedef struct Game{
-	
-	// board settings
-	int width;
-	int height;
-	int mines;
-	int totalTiles;
-	
-	// current board
-	int *tile;
-	int *mask;
-	int freeSpace;
-	
-	// menu
-	Vector *button;
-	Vector *buttonSize;
-	
-	// operational
-	int *revealQueue; // used to reveal nearby tiles upon clicking an empty tile
-	
-	// game state
-	int state; // -2: started, awaiting tile generation on click, -1: game lost, 1: game in progress (?), 2: game won
-	int isPaused;
-}Game;
-
 // setup
 int gameSetup(Game *game);
-void gameClear(Game *game);
-void gameStart(Game *game, int startTile);
-void gameResize(Game *game);
 void gameSettings(Game *game, DrawData *draw);
 void inputSetup(Input *input);
 int inputValue();
@@ -99,22 +87,21 @@ void gameUnpause(Game *game);
 
 // cursor
 void gameCursorPos(Game *game, Input *input, DrawData *draw);
-int gameTarget(Game *game, Input *input);
+int64_t gameTarget(Game *game, Input *input);
 int menuTarget(Game *game, Input *input);
 
-// game operations
-void gameTileCheck(int target, int *queueSize, Game *game);
-void gameTileReveal(int target, Game *game);
-void gameShowBombs(Game *game);
-void gameGetConnectedTiles(int target, Game *game, int *pos);
-
 // drawing
 int drawSetup(Game *game, DrawData *draw, unsigned int texture);
+int drawReserve(Game *game, DrawData *draw);
 void drawGame(DrawData *draw);
 void drawMenu(DrawData *draw);
 void drawScale(Game *game, DrawData *draw);
-void drawRetile(Game *game, DrawData *draw);
+int drawRetile(Game *game, DrawData *draw);
 void drawUpdate(Game *game, DrawData *draw);
+int drawValue(Game *game, int64_t i);
+void drawTile(DrawData *draw, int64_t t, int value);
+void drawTileUV(DrawData *draw, int64_t t);
+void drawStateRows(DrawData *draw);
 
 // cleanup
 void gameCleanup(Game *game);
@@ -125,23 +112,16 @@ void drawCleanup(DrawData *draw);
 int gameSetup(Game *game){
 	
 	// game
-	game->width = GAME_WIDTH;
-	game->height = GAME_HEIGHT;
-	game->mines = GAME_MINES;
-	game->totalTiles = game->width * game->height;
-	game->tile = malloc(sizeof(int) * game->totalTiles);
-	game->mask = malloc(sizeof(int) * game->totalTiles);
-	game->revealQueue = malloc(sizeof(int) * game->totalTiles);
-	if(game->tile == NULL || game->mask == NULL || game->revealQueue == NULL)
+	if(gameBoardSetup(game, GAME_WIDTH, GAME_HEIGHT, GAME_MINES))
 		return -1;
-	gameClear(game);
+	gamePrepare(game);
 	gamePause(game);
 	
 	// menu
-	game->button = malloc(sizeof(Vector) * BUTTON_TOTAL);
-	game->buttonSize = malloc(sizeof(Vector) * BUTTON_TOTAL);
-	if(game->button == NULL || game->buttonSize == NULL)
+	game->button = malloc(sizeof(Vector) * 2 * BUTTON_TOTAL);
+	if(game->button == NULL)
 		return -1;
+	game->buttonSize = game->button + BUTTON_TOTAL;
 	for(int b = 0; b < BUTTON_TOTAL; b++){
 		float x = 0.f;
 		float y = 0.f - (float)b * BUTTON_GAP;
@@ -154,90 +134,6 @@ int gameSetup(Game *game){
 	return 0;
 }
 
-void gameClear(Game *game){
-	for(int i = 0; i < game->totalTiles; i++)
-		game->mask[i] = 1;
-	game->state = 0;
-}
-
-void gameStart(Game *game, int startTile){
-	
-	// reset board
-	for(int t = 0; t < game->totalTiles; t++)
-		game->tile[t] = 0;
-	
-	// place mines
-	srand(time(NULL));
-	int safezone[9];
-	gameGetConnectedTiles(startTile, game, (int*)&safezone);
-	safezone[8] = startTile;
-	int bombs = 0;
-	game->freeSpace = game->totalTiles - game->mines;
-	
-	// place mines near starting tile upon necessity
-	int safeTiles = 0;
-	for(int z = 0; z < 8; z++)
-		safeTiles += safezone[z] != -1 ? 1 : 0;
-	if(game->freeSpace - safeTiles <= 0){
-		int safeAreaBombs = safeTiles - game->freeSpace + 1;
-		int shuffle[8] = { 0, 1, 2, 3, 4, 5, 6, 7 }; // Fisher-Yates shuffle
-		for(int i = 0; i < 7; i++){
-			int j = i + rand() % (8 - i);
-			int t = shuffle[i];
-			shuffle[i] = shuffle[j];
-			shuffle[j] = t;
-		}
-		for(int b = 0; bombs < safeAreaBombs; b++){
-			if(safezone[shuffle[b]] >= 0){
-				game->tile[safezone[shuffle[b]]] = -1;
-				bombs++;
-			}
-		}
-	}
-	
-	// place other mines away from starting tile
-	while(bombs < game->mines){
-		int bombPos = rand() % game->totalTiles;
-		int setBomb = 1;
-		for(int z = 0; z < 9; z++){
-			if(bombPos == safezone[z] || game->tile[bombPos] == -1){
-				setBomb = 0;
-				break;
-			}
-		}
-		game->tile[bombPos] = -setBomb;
-		bombs += setBomb;
-	}
-	
-	// count mines
-	for(int t = 0; t < game->totalTiles; t++){
-		if(game->tile[t] == -1) continue;
-		
-		int point[8];
-		gameGetConnectedTiles(t, game, (int*)&point);
-		
-		int count = 0;
-		for(int p = 0; p < 8; p++){
-			if(point[p] != -1)
-				count += (game->tile[point[p]] == -1 ? 1 : 0);
-		}
-		game->tile[t] = count;
-	}
-	
-	// set play state
-	game->state = 1;
-}
-
-void gameResize(Game *game){
-	free(game->tile);
-	free(game->mask);
-	free(game->revealQueue);
-	game->totalTiles = game->width * game->height;
-	game->tile = malloc(sizeof(int) * game->totalTiles);
-	game->mask = malloc(sizeof(int) * game->totalTiles);
-	game->revealQueue = malloc(sizeof(int) * game->totalTiles);
-}
-
 void gameSettings(Game *game, DrawData *draw){
 	
 	// set game options
@@ -250,18 +146,27 @@ void gameSettings(Game *game, DrawData *draw){
 		game->height = inputValue();
 		printf("Set GAME_MINES: ");
 		game->mines = inputValue();
-		if(game->width * game->height <= game->mines){
+		if(game->width < 1 || game->height < 1){
+			printf("Settings not accepted: empty field\n");
+			settingsAccepted = 0;
+		}
+		else if((int64_t)game->width * game->height <= game->mines){
 			printf("Settings not accepted: mines overfill field\n");
 			settingsAccepted = 0;
 		}
+		else if(gameResize(game)){
+			printf("Settings not accepted: field too large for memory\n");
+			settingsAccepted = 0;
+		}
+		else if(drawRetile(game, draw)){
+			printf("Settings not accepted: field too large to draw\n");
+			settingsAccepted = 0;
+		}
 	}
 	
-	// resize
-	gameResize(game);
-	drawRetile(game, draw);
-	
 	// reset game
 	gameClear(game);
+	gamePrepare(game);
 	
 	printf("Game Set\n");
 }
@@ -295,29 +200,14 @@ int inputValue(){
 // update functions
 
 int gameUpdate(Input *input, Game *game){
-	int targetTile = gameTarget(game, input);
+	int64_t targetTile = gameTarget(game, input);
 	
 	// select tile
 	if(input->select){
 		if(targetTile >= 0 && targetTile < game->totalTiles){
-			
-			if(game->state == 0) // start game
-				gameStart(game, targetTile);
-			
-			if(game->mask[targetTile] == 1){ // reveal tile
-				gameTileReveal(targetTile, game);
-				
-				if(game->tile[targetTile] == -1){ // game lost
-					game->state = 2;
-					gameShowBombs(game);
-					gamePause(game);
-				}
-				
-				else if(game->freeSpace <= 0){ // game won
-					game->state = 3;
-					gamePause(game);
-				}
-			}
+			gameSelect(game, targetTile);
+			if(game->state == 2 || game->state == 3) // game lost or won
+				gamePause(game);
 		}
 		input->select = 0;
 		return 1;
@@ -325,12 +215,8 @@ int gameUpdate(Input *input, Game *game){
 	
 	// flag bomb on tile
 	if(input->flag){
-		if(targetTile >= 0){
-			if(game->mask[targetTile] == 1)
-				game->mask[targetTile] = 2;
-			else if(game->mask[targetTile] == 2)
-				game->mask[targetTile] = 1;
-		}
+		if(targetTile >= 0)
+			gameFlag(game, targetTile);
 		input->flag = 0;
 		return 1;
 	}
@@ -353,8 +239,10 @@ int menuUpdate(Input *input, Game *game){
 		int updateType = 1;
 		switch(target){
 			case 1: // Continue/Reset
-				if(game->state == 2 || game->state == 3) // new game
+				if(game->state == 2 || game->state == 3){ // new game, generated while still in the menu
 					gameClear(game);
+					gamePrepare(game);
+				}
 				gameUnpause(game);
 				break;
 			case 2: // Settings
@@ -393,11 +281,11 @@ void gameCursorPos(Game *game, Input *input, DrawData *draw){
 	input->selectPos.y = (input->selectPos.y / draw->gameSize.y + 1.f) / 2.f;
 }
 
-int gameTarget(Game *game, Input *input){
+int64_t gameTarget(Game *game, Input *input){
 	int x = (int)(input->selectPos.x * game->width);
 	int y = (int)(input->selectPos.y * game->height);
 	if(x >= 0 && x < game->width && y >= 0 && y < game->height)
-		return x + (y * game->width);
+		return x + ((int64_t)y * game->width);
 	return -1;
 }
 
@@ -413,82 +301,20 @@ int menuTarget(Game *game, Input *input){
 	return -1;
 }
 
-// game operation functions
-
-void gameTileCheck(int target, int *queueSize, Game *game){
-	if(game->mask[target] == 1){
-		game->revealQueue[*queueSize] = target;
-		*queueSize += 1;
-		game->mask[target] = 0;
-	}
-}
-
-void gameTileReveal(int target, Game *game){
-	game->mask[target] = 0;
-	int *reveal = game->revealQueue;
-	reveal[0] = target;
-	int queueSize = 1;
-	
-	int spaceFreed;
-	for(spaceFreed = 0; spaceFreed < queueSize; spaceFreed++){
-		if(game->tile[reveal[spaceFreed]] == 0){
-			int pos[8];
-			gameGetConnectedTiles(reveal[spaceFreed], game, (int*)&pos);
-			for(int i = 0; i < 8; i++){
-				if(pos[i] >= 0)
-					gameTileCheck(pos[i], &queueSize, game);
-			}
-		}
-	}
-	game->freeSpace -= spaceFreed;
-}
-
-void gameShowBombs(Game *game){
-	int i;
-	for(i = 0; i < game->totalTiles; i++)
-		if(game->mask[i] == 1 && game->tile[i] == -1)
-			game->mask[i] = 0;
-}
-
-void gameGetConnectedTiles(int target, Game *game, int *pos){
-	pos[0] = target - game->width - 1;
-	pos[1] = target - game->width;
-	pos[2] = target - game->width + 1;
-	pos[3] = target - 1;
-	pos[4] = target + 1;
-	pos[5] = target + game->width - 1;
-	pos[6] = target + game->width;
-	pos[7] = target + game->width + 1;
-	if(target < game->width)
-		pos[0] = pos[1] = pos[2] = -1;
-	if(target >= game->width * game->height - game->width)
-		pos[5] = pos[6] = pos[7] = -1;
-	if(target % game->width == 0)
-		pos[0] = pos[3] = pos[5] = -1;
-	if(target % game->width == game->width - 1)
-		pos[2] = pos[4] = pos[7] = -1;
-}
-
 // drawing functions
 
 int drawSetup(Game *game, DrawData *draw, unsigned int texture){
 	
+	// board shader, for the single-quad path
+	draw->quadTiles = DRAW_QUAD_TILES;
+	draw->program = boardShaderSetup();
+	draw->stateLimit = stateTextureLimit();
+	draw->stateTexture = 0;
+	
 	// data allocation
-	draw->n = game->totalTiles;
-	draw->tile = malloc(sizeof(Vector) * draw->n);
-	draw->value = malloc(sizeof(float) * draw->n);
-	draw->buttonPos = malloc(sizeof(Vector) * BUTTON_TOTAL);
-	draw->buttonSize = malloc(sizeof(Vector) * BUTTON_TOTAL);
-	draw->titleUVLo = malloc(sizeof(Vector) * 4);
-	draw->titleUVHi = malloc(sizeof(Vector) * 4);
-	draw->buttonUVLo = malloc(sizeof(Vector) * BUTTON_TOTAL);
-	draw->buttonUVHi = malloc(sizeof(Vector) * BUTTON_TOTAL);
-	draw->tileUVLo = malloc(sizeof(Vector) * 12);
-	draw->tileUVHi = malloc(sizeof(Vector) * 12);
-	if(
-			draw->tile == NULL || draw->value == NULL || draw->buttonPos == NULL || draw->buttonSize == NULL || 
-			draw->titleUVLo == NULL || draw->titleUVHi == NULL || draw->buttonUVLo == NULL || draw->buttonUVHi == NULL || 
-			draw->tileUVLo == NULL || draw->tileUVHi == NULL)
+	arenaSetup(&draw->arena);
+	draw->allocations = 0;
+	if(drawReserve(game, draw))
 		return -1;
 	
 	// data initialisation
@@ -502,7 +328,6 @@ int drawSetup(Game *game, DrawData *draw, unsigned int texture){
 		draw->buttonSize[b].x = BUTTON_WIDTH;
 		draw->buttonSize[b].y = BUTTON_HEIGHT;
 	}
-	drawUpdate(game, draw);
 	
 	// textures and half-pixel corrected uv coordinates
 	draw->texture = texture;
@@ -526,16 +351,65 @@ int drawSetup(Game *game, DrawData *draw, unsigned int texture){
 		draw->tileUVLo[t].y = draw->texScale.y * .5f;
 		draw->tileUVHi[t].y = draw->texScale.y * 7 + draw->tileUVLo[t].y;
 	}
+	drawUpdate(game, draw);
+	
+	return 0;
+}
+
+int drawReserve(Game *game, DrawData *draw){ // -1 on allocation failure, or for a board too large for the vertex array without a state texture
+	
+	// large boards take the single-quad path when a state texture of their size can be made
+	int64_t n = game->totalTiles;
+	stateTextureCleanup(draw->stateTexture);
+	draw->stateTexture = 0;
+	draw->quadBoard = draw->program != 0 && n >= draw->quadTiles && game->width <= draw->stateLimit && game->height <= draw->stateLimit;
+	if(draw->quadBoard){
+		draw->stateTexture = stateTextureSetup(game->width, game->height);
+		draw->quadBoard = draw->stateTexture != 0;
+	}
+	draw->boardWidth = game->width;
+	draw->boardHeight = game->height;
+	if(!draw->quadBoard && n > DRAW_VERTEX_TILES)
+		return -1;
+	size_t boardSize = draw->quadBoard ? arenaSize(n) + arenaSize(game->height) : arenaSize(sizeof(TileVertex) * 4 * n);
 	
+	// fixed-size arrays first, so they keep their place and contents whatever the board size
+	size_t size = arenaSize(sizeof(Vector) * BUTTON_TOTAL) * 4 + arenaSize(sizeof(Vector) * 4) * 2 + arenaSize(sizeof(Vector) * 12) * 2 + 
+		arenaSize(n) + boardSize;
+	int grown = arenaReserve(&draw->arena, size);
+	if(grown < 0)
+		return -1;
+	draw->allocations += grown;
+	arenaReset(&draw->arena);
+	draw->buttonPos = arenaTake(&draw->arena, sizeof(Vector) * BUTTON_TOTAL);
+	draw->buttonSize = arenaTake(&draw->arena, sizeof(Vector) * BUTTON_TOTAL);
+	draw->titleUVLo = arenaTake(&draw->arena, sizeof(Vector) * 4);
+	draw->titleUVHi = arenaTake(&draw->arena, sizeof(Vector) * 4);
+	draw->buttonUVLo = arenaTake(&draw->arena, sizeof(Vector) * BUTTON_TOTAL);
+	draw->buttonUVHi = arenaTake(&draw->arena, sizeof(Vector) * BUTTON_TOTAL);
+	draw->tileUVLo = arenaTake(&draw->arena, sizeof(Vector) * 12);
+	draw->tileUVHi = arenaTake(&draw->arena, sizeof(Vector) * 12);
+	draw->value = arenaTake(&draw->arena, n);
+	draw->vertex = NULL;
+	draw->state = draw->rowDirty = NULL;
+	if(draw->quadBoard){
+		draw->state = arenaTake(&draw->arena, n);
+		draw->rowDirty = arenaTake(&draw->arena, game->height);
+		memset(draw->rowDirty, 1, game->height);
+	}
+	else
+		draw->vertex = arenaTake(&draw->arena, sizeof(TileVertex) * 4 * n);
+	draw->n = n;
 	return 0;
 }
 
 void drawGame(DrawData *draw){
-	for(int t = 0; t < draw->n; t++){
-		drawTexture(
-			draw->tile[t].x, draw->tile[t].y, draw->tileSize.x, draw->tileSize.y, 
-			draw->texture, draw->tileUVLo[draw->value[t]].x, draw->tileUVHi[draw->value[t]].x, draw->tileUVHi[draw->value[t]].y, draw->tileUVLo[draw->value[t]].y);
+	if(draw->quadBoard){
+		drawStateRows(draw);
+		drawBoard(draw->program, draw->stateTexture, draw->texture, draw->gameSize.x, draw->gameSize.y, draw->boardWidth, draw->boardHeight);
 	}
+	else
+		drawQuads((float*)draw->vertex, (int)draw->n, draw->texture); // at most DRAW_VERTEX_TILES
 }
 
 void drawMenu(DrawData *draw){
@@ -569,55 +443,93 @@ void drawScale(Game *game, DrawData *draw){
 		draw->gameSize.x = 1.f;
 	}
 	
-	// game-relative tile size & positions
+	// game-relative tile size & quad corners, counter-clockwise from the top right
 	draw->tileSize.x = draw->gameSize.x / game->width;
 	draw->tileSize.y = draw->gameSize.y / game->height;
-	int index = 0;
-	for(int j = 0; j < game->height; j++){
+	TileVertex *vertex = draw->vertex;
+	for(int j = 0; vertex != NULL && j < game->height; j++){
 		for(int i = 0; i < game->width; i++){
-			draw->tile[index].x = (float)(i + .5f - .5f * game->width) * 2.f * draw->tileSize.x;
-			draw->tile[index].y = (float)(j + .5f - .5f * game->height) * 2.f * draw->tileSize.y;
-			index++;
+			float x = (float)(i + .5f - .5f * game->width) * 2.f * draw->tileSize.x;
+			float y = (float)(j + .5f - .5f * game->height) * 2.f * draw->tileSize.y;
+			vertex[0].pos.x = vertex[3].pos.x = x + draw->tileSize.x;
+			vertex[1].pos.x = vertex[2].pos.x = x - draw->tileSize.x;
+			vertex[0].pos.y = vertex[1].pos.y = y + draw->tileSize.y;
+			vertex[2].pos.y = vertex[3].pos.y = y - draw->tileSize.y;
+			vertex += 4;
 		}
 	}
 }
 
-void drawRetile(Game *game, DrawData *draw){
-	free(draw->tile);
-	free(draw->value);
-	draw->n = game->totalTiles;
-	draw->tile = malloc(sizeof(Vector) * draw->n);
-	draw->value = malloc(sizeof(float) * draw->n);
+int drawRetile(Game *game, DrawData *draw){ // -1 when the draw arrays cannot hold the board, which must not be drawn until a board that fits is retiled
+	if(drawReserve(game, draw))
+		return -1;
 	drawScale(game, draw);
+	return 0;
 }
 
 void drawUpdate(Game *game, DrawData *draw){
-	for(int i = 0; i < game->totalTiles; i++)
-		draw->value[i] = (game->mask[i] == 0 ? (game->tile[i] == -1 ? 9 : game->tile[i]) : 9 + game->mask[i]);
+	
+	// only the tiles changed since the last update, unless the whole board changed
+	if(game->dirtyAll){
+		for(int64_t i = 0; i < game->totalTiles; i++)
+			drawTile(draw, i, drawValue(game, i));
+	}
+	else{
+		for(int64_t d = 0; d < game->dirtyTotal; d++)
+			drawTile(draw, game->dirty[d], drawValue(game, game->dirty[d]));
+	}
+	gameDirtyReset(game);
 	draw->menuState = game->state;
 }
 
+int drawValue(Game *game, int64_t i){
+	return gameMask(game, i) == 0 ? (gameTile(game, i) == -1 ? 9 : gameTile(game, i)) : 9 + gameMask(game, i);
+}
+
+void drawTile(DrawData *draw, int64_t t, int value){
+	draw->value[t] = value;
+	if(draw->quadBoard){
+		draw->state[t] = value;
+		draw->rowDirty[t / draw->boardWidth] = 1;
+	}
+	else
+		drawTileUV(draw, t);
+}
+
+void drawTileUV(DrawData *draw, int64_t t){ // texture corners of a tile's value, matching its quad corners
+	TileVertex *vertex = draw->vertex + t * 4;
+	Vector lo = draw->tileUVLo[draw->value[t]], hi = draw->tileUVHi[draw->value[t]];
+	vertex[0].uv.x = vertex[3].uv.x = hi.x;
+	vertex[1].uv.x = vertex[2].uv.x = lo.x;
+	vertex[0].uv.y = vertex[1].uv.y = lo.y;
+	vertex[2].uv.y = vertex[3].uv.y = hi.y;
+}
+
+void drawStateRows(DrawData *draw){ // uploads each run of changed rows with one sub-image call
+	int row = 0;
+	while(row < draw->boardHeight){
+		if(!draw->rowDirty[row]){
+			row++;
+			continue;
+		}
+		int first = row;
+		while(row < draw->boardHeight && draw->rowDirty[row])
+			draw->rowDirty[row++] = 0;
+		stateTextureRows(draw->stateTexture, draw->boardWidth, first, row - first, draw->state);
+	}
+}
+
 // cleanup functions
 
 void gameCleanup(Game *game){
-	free(game->tile);
-	free(game->mask);
-	free(game->revealQueue);
+	gameBoardCleanup(game);
 	free(game->button);
-	free(game->buttonSize);
 }
 
 void drawCleanup(DrawData *draw){
-	free(draw->buttonPos);
-	free(draw->buttonSize);
-	free(draw->tile);
-	free(draw->value);
-	free(draw->titleUVLo);
-	free(draw->titleUVHi);
-	free(draw->buttonUVLo);
-	free(draw->buttonUVHi);
-	free(draw->tileUVLo);
-	free(draw->tileUVHi);
+	stateTextureCleanup(draw->stateTexture);
+	boardShaderCleanup(draw->program);
+	arenaCleanup(&draw->arena);
 }
 
 #endif
\ No newline at end of file
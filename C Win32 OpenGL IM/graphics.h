@@ -1,7 +1,16 @@
 #ifndef GRAPHICS
 #define GRAPHICS
 
+#ifdef _WIN32
 #include <gl/gl.h>
+#include <gl/glext.h>
+#define GRAPHICS_PROC(type, name) (type)wglGetProcAddress(#name) // past OpenGL 1.1, so looked up in the context's driver
+#else
+#define GL_GLEXT_PROTOTYPES
+#include <GL/gl.h>
+#include <GL/glext.h>
+#define GRAPHICS_PROC(type, name) name
+#endif
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
@@ -9,6 +18,50 @@
 #define TEXTURE_WIDTH 128
 #define TEXTURE_HEIGHT 128
 
+// shader entry points used by the board shader
+typedef struct GraphicsProcs{
+	PFNGLACTIVETEXTUREPROC activeTexture;
+	PFNGLCREATESHADERPROC createShader;
+	PFNGLSHADERSOURCEPROC shaderSource;
+	PFNGLCOMPILESHADERPROC compileShader;
+	PFNGLGETSHADERIVPROC getShaderiv;
+	PFNGLDELETESHADERPROC deleteShader;
+	PFNGLCREATEPROGRAMPROC createProgram;
+	PFNGLATTACHSHADERPROC attachShader;
+	PFNGLLINKPROGRAMPROC linkProgram;
+	PFNGLGETPROGRAMIVPROC getProgramiv;
+	PFNGLUSEPROGRAMPROC useProgram;
+	PFNGLDELETEPROGRAMPROC deleteProgram;
+	PFNGLGETUNIFORMLOCATIONPROC getUniformLocation;
+	PFNGLUNIFORM1IPROC uniform1i;
+	PFNGLUNIFORM2FPROC uniform2f;
+}GraphicsProcs;
+
+GraphicsProcs graphicsProcs;
+
+// board shader: the tile at each fragment looked up in a one-byte-per-tile state texture, then its value in the atlas
+const char *boardVertexShader = 
+	"#version 110\n"
+	"varying vec2 cell;\n"
+	"void main(){\n"
+	"	cell = gl_MultiTexCoord0.xy;\n"
+	"	gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;\n"
+	"}\n";
+const char *boardFragmentShader = 
+	"#version 110\n"
+	"uniform sampler2D state;\n"
+	"uniform sampler2D atlas;\n"
+	"uniform vec2 board;\n" // width and height in tiles
+	"uniform vec2 texScale;\n" // atlas texel size
+	"varying vec2 cell;\n"
+	"void main(){\n"
+	"	vec2 tile = min(floor(cell), board - 1.);\n"
+	"	float value = floor(texture2D(state, (tile + .5) / board).r * 255. + .5);\n"
+	"	vec2 inside = cell - tile;\n"
+	"	vec2 uv = texScale * (vec2(.5 + value * 8., .5) + 7. * vec2(inside.x, 1. - inside.y));\n"
+	"	gl_FragColor = texture2D(atlas, uv);\n"
+	"}\n";
+
 // screen
 void screenSetup();
 void screenClear();
@@ -17,6 +70,17 @@ void screenResize(float w, float h);
 // drawing
 unsigned int textureSetup(const char *fileName);
 void drawTexture(float x, float y, float w, float h, unsigned int texture, float uvl, float uvr, float uvb, float uvt);
+void drawQuads(const float *vertex, int quads, unsigned int texture);
+
+// board shader
+unsigned int boardShaderSetup();
+unsigned int boardShaderCompile(GLenum type, const char *source);
+void boardShaderCleanup(unsigned int program);
+int stateTextureLimit();
+unsigned int stateTextureSetup(int width, int height);
+void stateTextureRows(unsigned int texture, int width, int firstRow, int rows, const unsigned char *state);
+void stateTextureCleanup(unsigned int texture);
+void drawBoard(unsigned int program, unsigned int stateTexture, unsigned int texture, float w, float h, int width, int height);
 
 // screen functions
 
@@ -77,4 +141,151 @@ void drawTexture(float x, float y, float w, float h, unsigned int texture, float
 	glPopMatrix();
 }
 
+void drawQuads(const float *vertex, int quads, unsigned int texture){ // vertex: u, v, x, y of four corners per quad
+	glPushMatrix();
+	glEnable(GL_TEXTURE_2D);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glLoadIdentity();
+	glColor3f(1.f, 1.f, 1.f);
+	glNormal3f(0.f, 0.f, 1.f);
+	glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+	glEnableClientState(GL_VERTEX_ARRAY);
+	glTexCoordPointer(2, GL_FLOAT, sizeof(float) * 4, vertex);
+	glVertexPointer(2, GL_FLOAT, sizeof(float) * 4, vertex + 2);
+	glDrawArrays(GL_QUADS, 0, quads * 4);
+	glDisableClientState(GL_VERTEX_ARRAY);
+	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+	glDisable(GL_TEXTURE_2D);
+	glPopMatrix();
+}
+
+// board shader functions
+
+unsigned int boardShaderSetup(){ // 0 when the driver offers no shaders
+	graphicsProcs.activeTexture = GRAPHICS_PROC(PFNGLACTIVETEXTUREPROC, glActiveTexture);
+	graphicsProcs.createShader = GRAPHICS_PROC(PFNGLCREATESHADERPROC, glCreateShader);
+	graphicsProcs.shaderSource = GRAPHICS_PROC(PFNGLSHADERSOURCEPROC, glShaderSource);
+	graphicsProcs.compileShader = GRAPHICS_PROC(PFNGLCOMPILESHADERPROC, glCompileShader);
+	graphicsProcs.getShaderiv = GRAPHICS_PROC(PFNGLGETSHADERIVPROC, glGetShaderiv);
+	graphicsProcs.deleteShader = GRAPHICS_PROC(PFNGLDELETESHADERPROC, glDeleteShader);
+	graphicsProcs.createProgram = GRAPHICS_PROC(PFNGLCREATEPROGRAMPROC, glCreateProgram);
+	graphicsProcs.attachShader = GRAPHICS_PROC(PFNGLATTACHSHADERPROC, glAttachShader);
+	graphicsProcs.linkProgram = GRAPHICS_PROC(PFNGLLINKPROGRAMPROC, glLinkProgram);
+	graphicsProcs.getProgramiv = GRAPHICS_PROC(PFNGLGETPROGRAMIVPROC, glGetProgramiv);
+	graphicsProcs.useProgram = GRAPHICS_PROC(PFNGLUSEPROGRAMPROC, glUseProgram);
+	graphicsProcs.deleteProgram = GRAPHICS_PROC(PFNGLDELETEPROGRAMPROC, glDeleteProgram);
+	graphicsProcs.getUniformLocation = GRAPHICS_PROC(PFNGLGETUNIFORMLOCATIONPROC, glGetUniformLocation);
+	graphicsProcs.uniform1i = GRAPHICS_PROC(PFNGLUNIFORM1IPROC, glUniform1i);
+	graphicsProcs.uniform2f = GRAPHICS_PROC(PFNGLUNIFORM2FPROC, glUniform2f);
+	void **proc = (void**)&graphicsProcs;
+	for(int p = 0; p < sizeof(GraphicsProcs) / sizeof(void*); p++)
+		if(proc[p] == NULL)
+			return 0;
+	
+	// compile and link
+	unsigned int vertex = boardShaderCompile(GL_VERTEX_SHADER, boardVertexShader);
+	unsigned int fragment = boardShaderCompile(GL_FRAGMENT_SHADER, boardFragmentShader);
+	if(vertex == 0 || fragment == 0){
+		graphicsProcs.deleteShader(vertex);
+		graphicsProcs.deleteShader(fragment);
+		return 0;
+	}
+	unsigned int program = graphicsProcs.createProgram();
+	graphicsProcs.attachShader(program, vertex);
+	graphicsProcs.attachShader(program, fragment);
+	graphicsProcs.linkProgram(program);
+	graphicsProcs.deleteShader(vertex);
+	graphicsProcs.deleteShader(fragment);
+	int linked;
+	graphicsProcs.getProgramiv(program, GL_LINK_STATUS, &linked);
+	if(!linked){
+		graphicsProcs.deleteProgram(program);
+		return 0;
+	}
+	
+	// state on texture unit 0, atlas on unit 1
+	graphicsProcs.useProgram(program);
+	graphicsProcs.uniform1i(graphicsProcs.getUniformLocation(program, "state"), 0);
+	graphicsProcs.uniform1i(graphicsProcs.getUniformLocation(program, "atlas"), 1);
+	graphicsProcs.uniform2f(graphicsProcs.getUniformLocation(program, "texScale"), 1.f / TEXTURE_WIDTH, 1.f / TEXTURE_HEIGHT);
+	graphicsProcs.useProgram(0);
+	return program;
+}
+
+unsigned int boardShaderCompile(GLenum type, const char *source){
+	unsigned int shader = graphicsProcs.createShader(type);
+	graphicsProcs.shaderSource(shader, 1, &source, NULL);
+	graphicsProcs.compileShader(shader);
+	int compiled;
+	graphicsProcs.getShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+	if(!compiled){
+		graphicsProcs.deleteShader(shader);
+		return 0;
+	}
+	return shader;
+}
+
+void boardShaderCleanup(unsigned int program){
+	if(program != 0)
+		graphicsProcs.deleteProgram(program);
+}
+
+int stateTextureLimit(){
+	int limit;
+	glGetIntegerv(GL_MAX_TEXTURE_SIZE, &limit);
+	return limit;
+}
+
+unsigned int stateTextureSetup(int width, int height){ // 0 when the driver cannot hold the texture
+	int bound;
+	glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound);
+	unsigned int texture;
+	glGenTextures(1, &texture);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+	glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+	while(glGetError() != GL_NO_ERROR);
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_LUMINANCE8, width, height, 0, GL_LUMINANCE, GL_UNSIGNED_BYTE, NULL);
+	int failed = glGetError() != GL_NO_ERROR;
+	glBindTexture(GL_TEXTURE_2D, bound); // drawTexture draws with whatever is bound
+	if(failed){
+		glDeleteTextures(1, &texture);
+		return 0;
+	}
+	return texture;
+}
+
+void stateTextureRows(unsigned int texture, int width, int firstRow, int rows, const unsigned char *state){ // state: the whole board, one byte per tile
+	glBindTexture(GL_TEXTURE_2D, texture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, firstRow, width, rows, GL_LUMINANCE, GL_UNSIGNED_BYTE, state + (size_t)firstRow * width);
+}
+
+void stateTextureCleanup(unsigned int texture){
+	if(texture != 0)
+		glDeleteTextures(1, &texture);
+}
+
+void drawBoard(unsigned int program, unsigned int stateTexture, unsigned int texture, float w, float h, int width, int height){ // one quad of half-size w, h
+	glPushMatrix();
+	glLoadIdentity();
+	graphicsProcs.useProgram(program);
+	graphicsProcs.uniform2f(graphicsProcs.getUniformLocation(program, "board"), (float)width, (float)height);
+	graphicsProcs.activeTexture(GL_TEXTURE1);
+	glBindTexture(GL_TEXTURE_2D, texture);
+	graphicsProcs.activeTexture(GL_TEXTURE0);
+	glBindTexture(GL_TEXTURE_2D, stateTexture);
+	glBegin(GL_QUADS);
+	glTexCoord2f(width, height); glVertex2f(w, h);
+	glTexCoord2f(0.f, height); glVertex2f(-w, h);
+	glTexCoord2f(0.f, 0.f); glVertex2f(-w, -h);
+	glTexCoord2f(width, 0.f); glVertex2f(w, -h);
+	glEnd();
+	glBindTexture(GL_TEXTURE_2D, texture);
+	graphicsProcs.useProgram(0);
+	glPopMatrix();
+}
+
 #endif
\ No newline at end of file
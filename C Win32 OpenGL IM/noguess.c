@@ -0,0 +1,227 @@
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "noguess.h"
+
+typedef struct NoGuessJob{
+	NoGuess *noGuess;
+	int64_t startTile;
+	uint64_t seed; // candidate k is generated from randomHash(seed, k), whichever thread takes it
+	atomic_llong next;
+	atomic_llong best; // lowest candidate accepted so far
+	atomic_llong raced;
+}NoGuessJob;
+
+typedef struct NoGuessTask{
+	NoGuessJob *job;
+	int index;
+}NoGuessTask;
+
+void *noGuessWorker(void *data);
+
+// setup functions
+
+int noGuessSetup(NoGuess *noGuess, int width, int height, int64_t mines, int threads){
+	noGuess->width = width;
+	noGuess->height = height;
+	noGuess->mines = mines;
+	noGuess->threads = threads > 0 ? threads : gameCpuCount();
+	noGuess->ready = 0;
+	noGuess->boards = noGuess->attempts = noGuess->raced = noGuess->repairs = 0;
+	noGuess->board = calloc(noGuess->threads, sizeof(Game));
+	noGuess->solver = calloc(noGuess->threads, sizeof(Solver));
+	noGuess->accepted = calloc(noGuess->threads, sizeof(int64_t));
+	noGuess->repaired = calloc(noGuess->threads, sizeof(int));
+	if(noGuess->board == NULL || noGuess->solver == NULL || noGuess->accepted == NULL || noGuess->repaired == NULL)
+		return -1;
+	for(; noGuess->ready < noGuess->threads; noGuess->ready++){
+		Game *board = &noGuess->board[noGuess->ready];
+		solverSetup(&noGuess->solver[noGuess->ready]);
+		if(gameBoardSetup(board, width, height, mines))
+			return -1;
+		board->trackFrontier = 1;
+		board->threads = 1; // the threads race candidates rather than share a reveal
+	}
+	return 0;
+}
+
+// generation functions
+
+int noGuessStart(Game *game, int64_t startTile){ // for Game.generate, with the NoGuess in Game.generator
+	return noGuessGenerate(game->generator, game, startTile);
+}
+
+int noGuessGenerate(NoGuess *noGuess, Game *game, int64_t startTile){ // starts game as gameStart does on a board solvable from startTile by deduction, -1 if none was found
+	if(game->width != noGuess->width || game->height != noGuess->height || game->mines != noGuess->mines)
+		return -1;
+	NoGuessJob job;
+	job.noGuess = noGuess;
+	job.startTile = startTile;
+	job.seed = game->random.next(&game->random);
+	atomic_init(&job.next, 0);
+	atomic_init(&job.best, NOGUESS_ATTEMPTS);
+	atomic_init(&job.raced, 0);
+	
+	// the calling thread works alongside threads - 1 others, each stopping once no lower candidate is left to try
+	pthread_t *worker = malloc(sizeof(pthread_t) * noGuess->threads);
+	NoGuessTask *task = malloc(sizeof(NoGuessTask) * noGuess->threads);
+	if(worker == NULL || task == NULL){
+		free(worker);
+		free(task);
+		return -1;
+	}
+	for(int t = 0; t < noGuess->threads; t++){
+		task[t].job = &job;
+		task[t].index = t;
+	}
+	int started = 1;
+	for(; started < noGuess->threads; started++)
+		if(pthread_create(&worker[started], NULL, noGuessWorker, &task[started]))
+			break;
+	noGuessWorker(&task[0]);
+	for(int t = 1; t < started; t++)
+		pthread_join(worker[t], NULL);
+	free(worker);
+	free(task);
+	
+	// the lowest accepted candidate, the same whichever threads ran
+	int64_t best = atomic_load(&job.best);
+	noGuess->raced += atomic_load(&job.raced);
+	int w = 0;
+	while(w < started && noGuess->accepted[w] != best)
+		w++;
+	if(best >= NOGUESS_ATTEMPTS || w == started)
+		return -1;
+	for(int64_t t = 0; t < game->totalTiles; t++)
+		gameSetTile(game, t, gameTile(&noGuess->board[w], t));
+	noGuess->boards++;
+	noGuess->attempts += best + 1;
+	noGuess->repairs += noGuess->repaired[w];
+	
+	// set play state
+	game->freeSpace = game->totalTiles - game->mines;
+	if(game->labelRegions)
+		gameLabelRegions(game);
+	game->dirtyAll = 1;
+	game->frontierStale = 1;
+	game->prepared = 0;
+	game->state = 1;
+	return 0;
+}
+
+void *noGuessWorker(void *data){
+	NoGuessTask *task = data;
+	NoGuessJob *job = task->job;
+	NoGuess *noGuess = job->noGuess;
+	noGuess->accepted[task->index] = -1;
+	for(int64_t k = atomic_fetch_add(&job->next, 1); k < atomic_load(&job->best); k = atomic_fetch_add(&job->next, 1)){
+		atomic_fetch_add(&job->raced, 1);
+		int repairs;
+		if(!noGuessCandidate(&noGuess->board[task->index], &noGuess->solver[task->index], job->startTile, randomHash(job->seed, k), &repairs)) continue;
+		noGuess->accepted[task->index] = k;
+		noGuess->repaired[task->index] = repairs;
+		
+		// later candidates of this thread are all higher, so it stops here, lowering the best unless another thread beat it
+		long long best = atomic_load(&job->best);
+		while(k < best && !atomic_compare_exchange_weak(&job->best, &best, k));
+		break;
+	}
+	return NULL;
+}
+
+// candidate functions
+
+int noGuessCandidate(Game *board, Solver *solver, int64_t startTile, uint64_t seed, int *repairs){ // 1 if the candidate, with its mines moved as needed, solves from startTile by deduction alone
+	gameClear(board);
+	gameSeed(board, seed);
+	gameStart(board, startTile);
+	gameTileReveal(startTile, board);
+	int limit = NOGUESS_REPAIRS + (int)(board->totalTiles / NOGUESS_REPAIR_TILES);
+	int fresh = 1; // played from the first click with no mine moved since
+	*repairs = 0;
+	while(1){
+		noGuessPlay(board, solver);
+		if(board->freeSpace == 0){
+			if(fresh)
+				return 1;
+			
+			// openings before a repair leant on counts it changed, so the repaired board is played again from the first click
+			gameClear(board);
+			board->freeSpace = board->totalTiles - board->mines;
+			gameTileReveal(startTile, board);
+			fresh = 1;
+			continue;
+		}
+		if(*repairs == limit || noGuessRepair(board))
+			return 0;
+		(*repairs)++;
+		fresh = 0;
+	}
+}
+
+void noGuessPlay(Game *board, Solver *solver){ // opens and flags deductions until none are left
+	while(board->freeSpace > 0 && solverUpdate(solver, board) > 0){
+		for(int64_t i = 0; i < solver->safeTotal; i++)
+			if(gameMask(board, solver->safe[i]) == 1)
+				gameTileReveal(solver->safe[i], board);
+		for(int64_t i = 0; i < solver->mineTotal; i++)
+			gameFlag(board, solver->mine[i]);
+	}
+}
+
+int noGuessRepair(Game *board){ // moves a random undecided mine next to a revealed count to a random hidden tile, one next to no count where any is left; -1 if either is missing
+	gameFrontierUpdate(board);
+	if(board->frontierStale)
+		return -1;
+	
+	// every deduced mine is flagged, so the hidden mines around the frontier are the undecided ones
+	int64_t from = -1, seen = 0;
+	for(int64_t f = 0; f < board->frontierTotal; f++){
+		int64_t count = board->frontier[f];
+		if(!(board->frontierMark[count] & FRONTIER_ON)) continue;
+		int64_t pos[8];
+		gameGetConnectedTiles(count, board, (int64_t*)&pos);
+		for(int p = 0; p < 8; p++)
+			if(pos[p] >= 0 && gameMask(board, pos[p]) == 1 && gameTile(board, pos[p]) == -1 && randomBelow64(&board->random, ++seen) == 0)
+				from = pos[p];
+	}
+	if(from < 0)
+		return -1;
+	
+	// preferably away from every revealed count, so no count the player has seen changes there; late in play none may be left, and the replay checks either kind
+	int64_t clearTo = -1, anyTo = -1, clearSeen = 0, anySeen = 0;
+	for(int64_t to = 0; to < board->totalTiles; to++){
+		if(gameMask(board, to) != 1 || gameTile(board, to) == -1) continue;
+		int64_t pos[8];
+		gameGetConnectedTiles(to, board, (int64_t*)&pos);
+		int clear = 1;
+		for(int p = 0; p < 8 && clear; p++)
+			clear = pos[p] < 0 || gameMask(board, pos[p]) != 0;
+		if(clear && randomBelow64(&board->random, ++clearSeen) == 0)
+			clearTo = to;
+		if(randomBelow64(&board->random, ++anySeen) == 0)
+			anyTo = to;
+	}
+	if(anyTo < 0)
+		return -1;
+	return gameMineMove(board, from, clearTo >= 0 ? clearTo : anyTo);
+}
+
+// cleanup functions
+
+void noGuessCleanup(NoGuess *noGuess){
+	for(int w = 0; w < noGuess->ready; w++){
+		gameBoardCleanup(&noGuess->board[w]);
+		solverCleanup(&noGuess->solver[w]);
+	}
+	free(noGuess->board);
+	free(noGuess->solver);
+	free(noGuess->accepted);
+	free(noGuess->repaired);
+	noGuess->board = NULL;
+	noGuess->solver = NULL;
+	noGuess->accepted = NULL;
+	noGuess->repaired = NULL;
+	noGuess->ready = 0;
+}
@@ -0,0 +1,47 @@
+#ifndef NOGUESS
+#define NOGUESS
+
+#include <stdint.h>
+
+#include "board.h"
+#include "solver.h"
+
+#define NOGUESS_ATTEMPTS 100000 // candidates tried before a generation gives up
+#define NOGUESS_REPAIRS 16 // mines a candidate may have moved off its frontier, plus one per NOGUESS_REPAIR_TILES tiles
+#define NOGUESS_REPAIR_TILES 64
+
+// boards solvable from the first click by deduction alone, candidates raced across threads
+typedef struct NoGuess{
+	int width;
+	int height;
+	int64_t mines;
+	int threads;
+	int ready; // boards set up, freed by noGuessCleanup
+	Game *board; // per thread: its candidate, keeping a frontier for solverUpdate
+	Solver *solver;
+	int64_t *accepted; // per thread: the candidate its board holds once accepted, -1 otherwise
+	int *repaired; // per thread: mines moved in its accepted candidate
+	
+	// counters over every generation
+	long long boards;
+	long long attempts; // candidates up to and including each accepted one, as many as one thread needs
+	long long raced; // candidates generated by every thread, those past the accepted one included
+	long long repairs; // mines moved in accepted candidates
+}NoGuess;
+
+// setup
+int noGuessSetup(NoGuess *noGuess, int width, int height, int64_t mines, int threads);
+
+// generation
+int noGuessStart(Game *game, int64_t startTile);
+int noGuessGenerate(NoGuess *noGuess, Game *game, int64_t startTile);
+
+// candidates
+int noGuessCandidate(Game *board, Solver *solver, int64_t startTile, uint64_t seed, int *repairs);
+void noGuessPlay(Game *board, Solver *solver);
+int noGuessRepair(Game *board);
+
+// cleanup
+void noGuessCleanup(NoGuess *noGuess);
+
+#endif
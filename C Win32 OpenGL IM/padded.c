@@ -0,0 +1,86 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "padded.h"
+
+#define PADDED_IS_MINE(c) (((c) & CELL_TILE) == CELL_MINE)
+
+// setup functions
+
+int paddedSetup(PaddedBoard *board, int width, int height){
+	board->width = width;
+	board->height = height;
+	board->stride = (int64_t)width + 2;
+	int64_t total = board->stride * ((int64_t)height + 2);
+	board->cell = malloc(sizeof(unsigned char) * total);
+	board->revealQueue = malloc(sizeof(int64_t) * width * height);
+	if(board->cell == NULL || board->revealQueue == NULL)
+		return -1;
+	memset(board->cell, PADDED_BORDER << CELL_MASK_SHIFT, total);
+	int64_t s = board->stride;
+	int64_t offset[8] = { -s - 1, -s, -s + 1, -1, 1, s - 1, s, s + 1 };
+	memcpy(board->offset, offset, sizeof(offset));
+	board->freeSpace = 0;
+	return 0;
+}
+
+void paddedLoad(PaddedBoard *board, Game *game){
+	gameSettle(game);
+	for(int y = 0; y < board->height; y++)
+		memcpy(board->cell + (y + 1) * board->stride + 1, game->cell + (int64_t)y * board->width, board->width);
+	board->freeSpace = game->freeSpace;
+}
+
+int64_t paddedIndex(PaddedBoard *board, int64_t tile){
+	return tile + board->stride + 1 + 2 * (tile / board->width);
+}
+
+// board operation functions
+
+void paddedCountMines(PaddedBoard *board){
+	int64_t s = board->stride;
+	for(int y = 1; y <= board->height; y++){
+		unsigned char *above = board->cell + (y - 1) * s;
+		unsigned char *row = above + s;
+		unsigned char *below = row + s;
+		for(int i = 1; i <= board->width; i++){
+			int count =
+				PADDED_IS_MINE(above[i - 1]) + PADDED_IS_MINE(above[i]) + PADDED_IS_MINE(above[i + 1]) +
+				PADDED_IS_MINE(row[i - 1]) + PADDED_IS_MINE(row[i + 1]) +
+				PADDED_IS_MINE(below[i - 1]) + PADDED_IS_MINE(below[i]) + PADDED_IS_MINE(below[i + 1]);
+			int mine = PADDED_IS_MINE(row[i]);
+			row[i] = (row[i] & ~CELL_TILE) | (mine ? CELL_MINE : count);
+		}
+	}
+}
+
+void paddedTileReveal(int64_t target, PaddedBoard *board){
+	unsigned char *cell = board->cell;
+	int64_t *offset = board->offset;
+	cell[target] &= CELL_TILE;
+	int64_t *reveal = board->revealQueue;
+	reveal[0] = target;
+	int64_t queueSize = 1;
+	
+	// the border is never hidden, so neighbours need no edge checks
+	int64_t spaceFreed;
+	for(spaceFreed = 0; spaceFreed < queueSize; spaceFreed++){
+		int64_t t = reveal[spaceFreed];
+		if((cell[t] & CELL_TILE) != 0) continue;
+		for(int p = 0; p < 8; p++){
+			int64_t n = t + offset[p];
+			if((cell[n] >> CELL_MASK_SHIFT) == 1){
+				reveal[queueSize++] = n;
+				cell[n] &= CELL_TILE;
+			}
+		}
+	}
+	board->freeSpace -= spaceFreed;
+}
+
+// cleanup functions
+
+void paddedCleanup(PaddedBoard *board){
+	free(board->cell);
+	free(board->revealQueue);
+}
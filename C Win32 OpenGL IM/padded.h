@@ -0,0 +1,31 @@
+#ifndef PADDED
+#define PADDED
+
+#include "board.h"
+
+#define PADDED_BORDER 3 // mask state of the sentinel border: never hidden, never a mine
+
+// board cells in rows of width + 2, with a one-cell sentinel border so every cell has 8 neighbours at constant offsets; 64-bit indices as in Game
+typedef struct PaddedBoard{
+	int width;
+	int height;
+	int64_t stride;
+	unsigned char *cell;
+	int64_t offset[8]; // neighbour offsets
+	int64_t *revealQueue;
+	int64_t freeSpace;
+}PaddedBoard;
+
+// setup
+int paddedSetup(PaddedBoard *board, int width, int height);
+void paddedLoad(PaddedBoard *board, Game *game);
+int64_t paddedIndex(PaddedBoard *board, int64_t tile);
+
+// board operations
+void paddedCountMines(PaddedBoard *board);
+void paddedTileReveal(int64_t target, PaddedBoard *board);
+
+// cleanup
+void paddedCleanup(PaddedBoard *board);
+
+#endif
@@ -0,0 +1,865 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+
+#include "probability.h"
+
+#define PROBABILITY_HASH 0x9E3779B97F4A7C15ull // multiplier spreading state keys over the table
+
+// one thread's scratch for sweeping components, kept across the components it claims
+typedef struct ProbabilitySweep{
+	Arena arena; // component layout below, carved again for each component
+	
+	// component layout: tiles as local indices, then as sweep positions once ordered
+	int64_t *countTile; // 8 per count
+	int *countSize;
+	int *countMines; // mines left around each count
+	int *countSlot;
+	int64_t *tileCountStart; // counts of each tile, tileTotal + 1 entries
+	int64_t *tileCount;
+	int64_t *order; // local tile at each sweep position
+	int64_t *position;
+	int64_t *seen;
+	int64_t *stepStart; // counts of the tile at each position, tileTotal + 1 entries
+	int *stepShift; // the count's 4 bits in the state key
+	int *stepMines;
+	int *stepAfter; // the count's tiles at later positions
+	int64_t *layerStart; // first state of each layer, tileTotal + 2 entries
+	
+	// states, each a key of open counts' mines so far and weights by mines so far
+	uint64_t *key;
+	int64_t *next; // 2 per state: the state after a safe tile and after a mine, -1 where the counts rule it out
+	int64_t stateCapacity;
+	double *value;
+	unsigned char *support; // per weight: 1 where some layout reaches it, kept exactly as weights may round to 0
+	int64_t valueCapacity;
+	int64_t *table; // open addressing from key to state, for the layer being built
+	int64_t tableCapacity;
+	double *back[2]; // backward pass: weights of completing the layouts from the later and the earlier layer
+	unsigned char *backSupport[2];
+	int64_t backCapacity;
+}ProbabilitySweep;
+
+typedef struct ProbabilityJob{
+	Probability *probability;
+	Game *game;
+	int marginals;
+	atomic_llong next;
+	atomic_int failed;
+}ProbabilityJob;
+
+void *probabilityWorker(void *data);
+void probabilitySweepSetup(ProbabilitySweep *sweep);
+int probabilitySweep(Probability *probability, Game *game, ProbabilitySweep *sweep, int64_t c, int marginals);
+int probabilitySweepLayout(Probability *probability, Game *game, ProbabilitySweep *sweep, ProbabilityComponent *component);
+int64_t probabilitySweepOrder(ProbabilitySweep *sweep, int64_t from, int64_t stamp);
+int probabilitySweepReserve(ProbabilitySweep *sweep, int64_t states, int width);
+int probabilitySweepTable(ProbabilitySweep *sweep, int64_t states);
+int probabilitySweepBack(ProbabilitySweep *sweep, int64_t size);
+void probabilitySweepCleanup(ProbabilitySweep *sweep);
+
+// setup functions
+
+void probabilitySetup(Probability *probability){
+	solverSetup(&probability->solver);
+	arenaSetup(&probability->arena);
+	arenaSetup(&probability->listArena);
+	probability->totalTiles = 0;
+	probability->probability = NULL;
+	probability->certain = NULL;
+	probability->threads = gameCpuCount();
+	probability->frontierOf = probability->tile = probability->count = NULL;
+	probability->component = NULL;
+	probability->node = NULL;
+	probability->tileTotal = probability->countTotal = probability->componentTotal = probability->nodeTotal = 0;
+}
+
+int probabilityResize(Probability *probability, int64_t totalTiles){
+	if(probability->probability != NULL && probability->totalTiles == totalTiles)
+		return 0;
+	size_t probabilitySize = sizeof(double) * totalTiles;
+	size_t certainSize = sizeof(unsigned char) * totalTiles;
+	size_t frontierSize = sizeof(int64_t) * totalTiles;
+	if(arenaReserve(&probability->arena, arenaSize(probabilitySize) + arenaSize(certainSize) + arenaSize(frontierSize)) < 0)
+		return -1;
+	arenaReset(&probability->arena);
+	probability->probability = arenaTake(&probability->arena, probabilitySize);
+	probability->certain = arenaTake(&probability->arena, certainSize);
+	probability->frontierOf = arenaTake(&probability->arena, frontierSize);
+	probability->totalTiles = totalTiles;
+	return 0;
+}
+
+// probability functions
+
+int probabilityRun(Probability *probability, Game *game){ // 0, -1 on allocation failure or no layout agreeing with the board
+	if(probabilityResize(probability, game->totalTiles) || solverScan(&probability->solver, game) < 0 || probabilityFrontier(probability, game))
+		return -1;
+	
+	// component weights by mines, components too wide to sweep folded into the interior, then what the rest of the board weighs against each, then each tile's share
+	int failed = probabilitySolve(probability, game, 0);
+	if(!failed)
+		probabilityEstimate(probability);
+	failed = failed || probabilityCombine(probability) || probabilitySolve(probability, game, 1);
+	for(int64_t n = 0; n < probability->nodeTotal; n++){
+		free(probability->node[n].weight.value);
+		free(probability->node[n].weight.support);
+		free(probability->node[n].outside.value);
+		free(probability->node[n].outside.support);
+	}
+	probability->nodeTotal = 0;
+	if(failed)
+		return -1;
+	
+	// interior tiles share the mines the frontier leaves alike
+	unsigned char *state = probability->solver.state;
+	for(int64_t t = 0; t < game->totalTiles; t++){
+		if(probability->frontierOf[t] < 0 && gameMask(game, t) == 1 && !(state[t] & (SOLVER_SAFE | SOLVER_MINE))){
+			probability->probability[t] = probability->interiorProbability;
+			probability->certain[t] = probability->interiorCertain;
+		}
+	}
+	return 0;
+}
+
+// frontier functions
+
+int probabilityFrontier(Probability *probability, Game *game){ // -1 on allocation failure or a mine total the board cannot hold
+	unsigned char *state = probability->solver.state;
+	int64_t frontier = 0, undecided = 0, flags = 0;
+	
+	// settled tiles take their probability here, undecided ones next to a revealed count join the frontier
+	for(int64_t t = 0; t < game->totalTiles; t++){
+		probability->frontierOf[t] = -1;
+		int mask = gameMask(game, t);
+		if(mask != 1 || state[t] & (SOLVER_SAFE | SOLVER_MINE)){
+			flags += mask == 2;
+			probability->probability[t] = mask == 2 || state[t] & SOLVER_MINE ? 1. : 0.;
+			probability->certain[t] = mask == 2 || state[t] & SOLVER_MINE ? PROBABILITY_MINE : PROBABILITY_SAFE;
+			continue;
+		}
+		undecided++;
+		int64_t pos[8];
+		gameGetConnectedTiles(t, game, (int64_t*)&pos);
+		for(int p = 0; p < 8; p++){
+			if(pos[p] >= 0 && gameMask(game, pos[p]) == 0 && gameTile(game, pos[p]) > 0){
+				probability->frontierOf[t] = frontier++;
+				break;
+			}
+		}
+	}
+	
+	// lists sized by the frontier, each count touching at most 8 frontier tiles
+	int64_t countBound = frontier * 8 < game->totalTiles ? frontier * 8 : game->totalTiles;
+	size_t placeSize = sizeof(int64_t) * frontier;
+	size_t countSize = sizeof(int64_t) * countBound;
+	size_t componentSize = sizeof(ProbabilityComponent) * frontier;
+	size_t nodeSize = sizeof(ProbabilityNode) * 2 * frontier;
+	if(arenaReserve(&probability->listArena, arenaSize(placeSize) * 4 + arenaSize(countSize) * 3 + arenaSize(componentSize) + arenaSize(nodeSize)) < 0)
+		return -1;
+	arenaReset(&probability->listArena);
+	int64_t *scan = arenaTake(&probability->listArena, placeSize);
+	int64_t *parent = arenaTake(&probability->listArena, placeSize);
+	int64_t *componentOf = arenaTake(&probability->listArena, placeSize);
+	probability->tile = arenaTake(&probability->listArena, placeSize);
+	int64_t *countScan = arenaTake(&probability->listArena, countSize);
+	int64_t *countOwner = arenaTake(&probability->listArena, countSize);
+	probability->count = arenaTake(&probability->listArena, countSize);
+	probability->component = arenaTake(&probability->listArena, componentSize);
+	probability->node = arenaTake(&probability->listArena, nodeSize);
+	
+	// frontier tiles sharing a count are joined
+	for(int64_t p = 0; p < frontier; p++){
+		parent[p] = p;
+		componentOf[p] = -1;
+	}
+	int64_t counts = 0;
+	for(int64_t t = 0; t < game->totalTiles; t++){
+		if(probability->frontierOf[t] >= 0){
+			scan[probability->frontierOf[t]] = t;
+			continue;
+		}
+		if(gameMask(game, t) != 0 || gameTile(game, t) <= 0) continue;
+		int64_t pos[8];
+		gameGetConnectedTiles(t, game, (int64_t*)&pos);
+		int64_t first = -1;
+		for(int p = 0; p < 8; p++){
+			if(pos[p] < 0 || probability->frontierOf[pos[p]] < 0) continue;
+			if(first < 0)
+				first = probability->frontierOf[pos[p]];
+			else{
+				int64_t a = probabilityRoot(parent, first), b = probabilityRoot(parent, probability->frontierOf[pos[p]]);
+				if(a != b)
+					parent[b] = a;
+			}
+		}
+		if(first >= 0){
+			countScan[counts] = t;
+			countOwner[counts++] = first;
+		}
+	}
+	
+	// components numbered in the order their first tile was reached, tiles and counts grouped by them
+	probability->componentTotal = 0;
+	for(int64_t p = 0; p < frontier; p++){
+		int64_t root = probabilityRoot(parent, p);
+		if(componentOf[root] < 0){
+			ProbabilityComponent *component = &probability->component[probability->componentTotal];
+			component->tileTotal = component->countTotal = 0;
+			component->states = 0;
+			component->width = 0;
+			component->estimated = 0;
+			componentOf[root] = probability->componentTotal++;
+		}
+		componentOf[p] = componentOf[root];
+		probability->component[componentOf[p]].tileTotal++;
+	}
+	for(int64_t k = 0; k < counts; k++){
+		countOwner[k] = componentOf[countOwner[k]];
+		probability->component[countOwner[k]].countTotal++;
+	}
+	int64_t tileFirst = 0, countFirst = 0;
+	probability->largest = 0;
+	for(int64_t c = 0; c < probability->componentTotal; c++){
+		ProbabilityComponent *component = &probability->component[c];
+		component->tileFirst = tileFirst;
+		component->countFirst = countFirst;
+		tileFirst += component->tileTotal;
+		countFirst += component->countTotal;
+		if(component->tileTotal > probability->largest)
+			probability->largest = component->tileTotal;
+		component->tileTotal = component->countTotal = 0;
+		probability->node[c].weight.value = probability->node[c].outside.value = NULL;
+		probability->node[c].weight.support = probability->node[c].outside.support = NULL;
+		probability->node[c].child[0] = probability->node[c].child[1] = -1;
+	}
+	for(int64_t p = 0; p < frontier; p++){
+		ProbabilityComponent *component = &probability->component[componentOf[p]];
+		int64_t place = component->tileFirst + component->tileTotal++;
+		probability->tile[place] = scan[p];
+		probability->frontierOf[scan[p]] = place;
+	}
+	for(int64_t k = 0; k < counts; k++){
+		ProbabilityComponent *component = &probability->component[countOwner[k]];
+		probability->count[component->countFirst + component->countTotal++] = countScan[k];
+	}
+	probability->tileTotal = frontier;
+	probability->countTotal = counts;
+	probability->nodeTotal = probability->componentTotal;
+	probability->estimated = 0;
+	
+	// the mines left, and a tilt matching one more frontier mine against one fewer in the interior at an even spread
+	probability->interior = undecided - frontier;
+	probability->minesLeft = game->mines - flags - probability->solver.mineTotal;
+	if(probability->minesLeft < 0 || probability->minesLeft > undecided)
+		return -1;
+	double spread = (double)frontier * probability->minesLeft / (undecided > 0 ? undecided : 1);
+	probability->tilt = (probability->minesLeft - spread + 1.) / (probability->interior - probability->minesLeft + spread + 1.);
+	return 0;
+}
+
+int64_t probabilityRoot(int64_t *parent, int64_t p){ // with path halving
+	while(parent[p] != p){
+		parent[p] = parent[parent[p]];
+		p = parent[p];
+	}
+	return p;
+}
+
+// component functions
+
+int probabilitySolve(Probability *probability, Game *game, int marginals){ // sweeps every component on the calling thread and threads - 1 others, -1 if any failed
+	ProbabilityJob job;
+	job.probability = probability;
+	job.game = game;
+	job.marginals = marginals;
+	atomic_init(&job.next, 0);
+	atomic_init(&job.failed, 0);
+	
+	int threads = probability->threads > 0 ? probability->threads : gameCpuCount();
+	if(threads > probability->componentTotal)
+		threads = probability->componentTotal > 0 ? (int)probability->componentTotal : 1;
+	pthread_t *worker = malloc(sizeof(pthread_t) * threads);
+	if(worker == NULL)
+		return -1;
+	int started = 1;
+	for(; started < threads; started++)
+		if(pthread_create(&worker[started], NULL, probabilityWorker, &job))
+			break;
+	probabilityWorker(&job);
+	for(int t = 1; t < started; t++)
+		pthread_join(worker[t], NULL);
+	free(worker);
+	
+	// counters of the weight sweeps
+	if(!marginals){
+		probability->states = 0;
+		probability->widest = 0;
+		for(int64_t c = 0; c < probability->componentTotal; c++){
+			probability->states += probability->component[c].states;
+			if(probability->component[c].width > probability->widest)
+				probability->widest = probability->component[c].width;
+		}
+	}
+	return atomic_load(&job.failed) ? -1 : 0;
+}
+
+void probabilityEstimate(Probability *probability){ // components past the sweep limits dropped, their tiles joining the interior with their counts left out, the others kept in order
+	int64_t kept = 0;
+	for(int64_t c = 0; c < probability->componentTotal; c++){
+		ProbabilityComponent *component = &probability->component[c];
+		if(!component->estimated){
+			probability->component[kept] = *component;
+			probability->node[kept++] = probability->node[c];
+			continue;
+		}
+		
+		// fewer layouts ruled out, so the other components' probabilities are estimates too, though tiles certain here are certain on the board
+		for(int64_t p = component->tileFirst; p < component->tileFirst + component->tileTotal; p++)
+			probability->frontierOf[probability->tile[p]] = -1;
+		probability->interior += component->tileTotal;
+		probability->estimated += component->tileTotal;
+		free(probability->node[c].weight.value);
+		free(probability->node[c].weight.support);
+	}
+	probability->componentTotal = probability->nodeTotal = kept;
+}
+
+void *probabilityWorker(void *data){
+	ProbabilityJob *job = data;
+	ProbabilitySweep sweep;
+	probabilitySweepSetup(&sweep);
+	for(int64_t c = atomic_fetch_add(&job->next, 1); c < job->probability->componentTotal; c = atomic_fetch_add(&job->next, 1)){
+		if(atomic_load(&job->failed)) break;
+		int swept = probabilitySweep(job->probability, job->game, &sweep, c, job->marginals);
+		if(swept < 0)
+			atomic_store(&job->failed, 1);
+		else if(swept > 0) // left to probabilityEstimate
+			job->probability->component[c].estimated = 1;
+	}
+	probabilitySweepCleanup(&sweep);
+	return NULL;
+}
+
+void probabilitySweepSetup(ProbabilitySweep *sweep){
+	arenaSetup(&sweep->arena);
+	sweep->key = NULL;
+	sweep->next = NULL;
+	sweep->value = NULL;
+	sweep->support = NULL;
+	sweep->table = NULL;
+	sweep->back[0] = sweep->back[1] = NULL;
+	sweep->backSupport[0] = sweep->backSupport[1] = NULL;
+	sweep->stateCapacity = sweep->valueCapacity = sweep->tableCapacity = sweep->backCapacity = 0;
+}
+
+int probabilitySweep(Probability *probability, Game *game, ProbabilitySweep *sweep, int64_t c, int marginals){ // component weights by mines, or with marginals each tile's probability; 1 past the sweep limits, -1 on failure
+	ProbabilityComponent *component = &probability->component[c];
+	ProbabilityNode *node = &probability->node[c];
+	int64_t tileTotal = component->tileTotal;
+	int laid = probabilitySweepLayout(probability, game, sweep, component);
+	if(laid)
+		return laid;
+	int width = (int)(tileTotal < probability->minesLeft ? tileTotal : probability->minesLeft) + 1;
+	double tilt = probability->tilt;
+	
+	// forward: the states reached after each tile, weighted by the layouts reaching them
+	if(probabilitySweepReserve(sweep, 1, width))
+		return -1;
+	sweep->layerStart[0] = 0;
+	sweep->layerStart[1] = 1;
+	sweep->key[0] = 0;
+	memset(sweep->value, 0, sizeof(double) * width);
+	memset(sweep->support, 0, width);
+	sweep->value[0] = 1.;
+	sweep->support[0] = 1;
+	double scale = 0.;
+	int64_t widestLayer = 1;
+	for(int64_t i = 0; i < tileTotal; i++){
+		int64_t first = sweep->layerStart[i], last = sweep->layerStart[i + 1], states = last;
+		int reach = (int)(i < width - 1 ? i : width - 1);
+		if(probabilitySweepTable(sweep, 2 * (last - first)))
+			return -1;
+		uint64_t mask = sweep->tableCapacity - 1;
+		for(int64_t s = first; s < last; s++){
+			for(int mine = 0; mine <= 1; mine++){
+				sweep->next[2 * s + mine] = -1;
+				
+				// the tile's counts take it, closing those it is the last tile of
+				uint64_t key = sweep->key[s];
+				int allowed = 1;
+				for(int64_t e = sweep->stepStart[i]; e < sweep->stepStart[i + 1]; e++){
+					int sum = (int)((key >> sweep->stepShift[e]) & 0x0F) + mine;
+					if(sum > sweep->stepMines[e] || sum + sweep->stepAfter[e] < sweep->stepMines[e]){
+						allowed = 0;
+						break;
+					}
+					key &= ~((uint64_t)0x0F << sweep->stepShift[e]);
+					if(sweep->stepAfter[e] > 0)
+						key |= (uint64_t)sum << sweep->stepShift[e];
+				}
+				if(!allowed) continue;
+				
+				// the state in the next layer, added on first reaching it
+				uint64_t h = (key * PROBABILITY_HASH >> 32) & mask;
+				while(sweep->table[h] >= 0 && sweep->key[sweep->table[h]] != key)
+					h = (h + 1) & mask;
+				int64_t n = sweep->table[h];
+				if(n < 0){
+					if((states + 1) * width > PROBABILITY_BUDGET)
+						return 1;
+					if(probabilitySweepReserve(sweep, states + 1, width))
+						return -1;
+					n = sweep->table[h] = states++;
+					sweep->key[n] = key;
+					memset(sweep->value + n * width, 0, sizeof(double) * width);
+					memset(sweep->support + n * width, 0, width);
+				}
+				sweep->next[2 * s + mine] = n;
+				double factor = mine ? tilt : 1.;
+				double *from = sweep->value + s * width, *to = sweep->value + n * width + mine;
+				unsigned char *fromSupport = sweep->support + s * width, *toSupport = sweep->support + n * width + mine;
+				for(int k = 0; k <= reach && k + mine < width; k++){
+					to[k] += from[k] * factor;
+					toSupport[k] |= fromSupport[k];
+				}
+			}
+		}
+		if(states == last)
+			return -1;
+		sweep->layerStart[i + 2] = states;
+		if(states - last > widestLayer)
+			widestLayer = states - last;
+		
+		// each layer scaled to a largest weight of 1
+		double largest = 0.;
+		for(int64_t v = last * width; v < states * width; v++)
+			if(sweep->value[v] > largest)
+				largest = sweep->value[v];
+		for(int64_t v = last * width; v < states * width; v++)
+			sweep->value[v] /= largest;
+		scale += log(largest);
+	}
+	int64_t final = sweep->layerStart[tileTotal];
+	
+	// the one state left, with every count closed, holds the component's weights
+	if(!marginals){
+		component->states = sweep->layerStart[tileTotal + 1];
+		node->weight.low = 0;
+		node->weight.size = width;
+		node->weight.scale = scale;
+		node->weight.value = malloc(sizeof(double) * width);
+		node->weight.support = malloc(width);
+		if(node->weight.value == NULL || node->weight.support == NULL)
+			return -1;
+		memcpy(node->weight.value, sweep->value + final * width, sizeof(double) * width);
+		memcpy(node->weight.support, sweep->support + final * width, width);
+		return probabilityPolyNormalise(&node->weight);
+	}
+	
+	// backward: weights of completing each state's layouts, the rest of the board included, met with the forward weights at each tile
+	if(probabilitySweepBack(sweep, widestLayer * width))
+		return -1;
+	double *after = sweep->back[0], *before = sweep->back[1];
+	unsigned char *afterSupport = sweep->backSupport[0], *beforeSupport = sweep->backSupport[1];
+	ProbabilityPoly *outside = &node->outside;
+	for(int k = 0; k < width; k++){
+		int inside = k >= outside->low && k < outside->low + outside->size;
+		after[k] = inside ? outside->value[k - outside->low] : 0.;
+		afterSupport[k] = inside ? outside->support[k - outside->low] : 0;
+	}
+	int64_t *tile = probability->tile + component->tileFirst;
+	for(int64_t i = tileTotal - 1; i >= 0; i--){
+		int64_t first = sweep->layerStart[i], last = sweep->layerStart[i + 1];
+		int reach = (int)(i < width - 1 ? i : width - 1);
+		double share[2] = { 0., 0. };
+		int possible[2] = { 0, 0 }; // some layout leaves the tile clear, mines it
+		memset(before, 0, sizeof(double) * (last - first) * width);
+		memset(beforeSupport, 0, (last - first) * width);
+		for(int64_t s = first; s < last; s++){
+			double *from = sweep->value + s * width, *to = before + (s - first) * width;
+			unsigned char *fromSupport = sweep->support + s * width, *toSupport = beforeSupport + (s - first) * width;
+			for(int mine = 0; mine <= 1; mine++){
+				int64_t n = sweep->next[2 * s + mine];
+				if(n < 0) continue;
+				double factor = mine ? tilt : 1.;
+				double *rest = after + (n - last) * width + mine;
+				unsigned char *restSupport = afterSupport + (n - last) * width + mine;
+				for(int k = 0; k <= reach && k + mine < width; k++){
+					to[k] += rest[k] * factor;
+					share[mine] += from[k] * rest[k] * factor;
+					toSupport[k] |= restSupport[k];
+					possible[mine] |= fromSupport[k] & restSupport[k];
+				}
+			}
+		}
+		if(share[0] + share[1] <= 0.)
+			return -1;
+		int64_t t = tile[sweep->order[i]];
+		probability->probability[t] = share[1] / (share[0] + share[1]);
+		probability->certain[t] = !possible[1] ? PROBABILITY_SAFE : !possible[0] ? PROBABILITY_MINE : 0;
+		
+		// scaled as the forward layers, the shares at each tile being relative
+		double largest = 0.;
+		for(int64_t v = 0; v < (last - first) * width; v++)
+			if(before[v] > largest)
+				largest = before[v];
+		for(int64_t v = 0; v < (last - first) * width; v++)
+			before[v] /= largest;
+		double *swap = after;
+		after = before;
+		before = swap;
+		unsigned char *swapSupport = afterSupport;
+		afterSupport = beforeSupport;
+		beforeSupport = swapSupport;
+	}
+	return 0;
+}
+
+int probabilitySweepLayout(Probability *probability, Game *game, ProbabilitySweep *sweep, ProbabilityComponent *component){ // counts, sweep order and state key bits of a component; 1 past PROBABILITY_SLOTS, -1 on failure
+	int64_t tileTotal = component->tileTotal, countTotal = component->countTotal;
+	size_t tileSize = sizeof(int64_t) * (tileTotal + 2);
+	size_t entrySize = sizeof(int64_t) * 8 * countTotal;
+	size_t countSize = sizeof(int) * countTotal;
+	size_t stepSize = sizeof(int) * 8 * countTotal;
+	if(arenaReserve(&sweep->arena, arenaSize(tileSize) * 6 + arenaSize(entrySize) * 2 + arenaSize(countSize) * 3 + arenaSize(stepSize) * 3) < 0)
+		return -1;
+	arenaReset(&sweep->arena);
+	sweep->countTile = arenaTake(&sweep->arena, entrySize);
+	sweep->tileCount = arenaTake(&sweep->arena, entrySize);
+	sweep->countSize = arenaTake(&sweep->arena, countSize);
+	sweep->countMines = arenaTake(&sweep->arena, countSize);
+	sweep->countSlot = arenaTake(&sweep->arena, countSize);
+	sweep->tileCountStart = arenaTake(&sweep->arena, tileSize);
+	sweep->order = arenaTake(&sweep->arena, tileSize);
+	sweep->position = arenaTake(&sweep->arena, tileSize);
+	sweep->seen = arenaTake(&sweep->arena, tileSize);
+	sweep->stepStart = arenaTake(&sweep->arena, tileSize);
+	sweep->layerStart = arenaTake(&sweep->arena, tileSize);
+	sweep->stepShift = arenaTake(&sweep->arena, stepSize);
+	sweep->stepMines = arenaTake(&sweep->arena, stepSize);
+	sweep->stepAfter = arenaTake(&sweep->arena, stepSize);
+	
+	// each count's frontier tiles and the mines left for them, flags and deduced mines taken off
+	unsigned char *state = probability->solver.state;
+	int64_t *count = probability->count + component->countFirst;
+	memset(sweep->tileCountStart, 0, sizeof(int64_t) * (tileTotal + 1));
+	for(int64_t k = 0; k < countTotal; k++){
+		int64_t pos[8];
+		gameGetConnectedTiles(count[k], game, (int64_t*)&pos);
+		int remaining = gameTile(game, count[k]), size = 0;
+		for(int p = 0; p < 8; p++){
+			if(pos[p] < 0) continue;
+			if(gameMask(game, pos[p]) == 2 || state[pos[p]] & SOLVER_MINE)
+				remaining--;
+			else if(probability->frontierOf[pos[p]] >= 0){
+				int64_t local = probability->frontierOf[pos[p]] - component->tileFirst;
+				sweep->countTile[k * 8 + size++] = local;
+				sweep->tileCountStart[local + 1]++;
+			}
+		}
+		if(remaining < 0 || remaining > size)
+			return -1;
+		sweep->countSize[k] = size;
+		sweep->countMines[k] = remaining;
+	}
+	for(int64_t v = 0; v < tileTotal; v++){
+		sweep->tileCountStart[v + 1] += sweep->tileCountStart[v];
+		sweep->seen[v] = sweep->tileCountStart[v];
+	}
+	for(int64_t k = 0; k < countTotal; k++)
+		for(int j = 0; j < sweep->countSize[k]; j++)
+			sweep->tileCount[sweep->seen[sweep->countTile[k * 8 + j]]++] = k;
+	
+	// breadth-first from a tile far from the first, so the counts open at once follow the frontier's width rather than its length
+	for(int64_t v = 0; v < tileTotal; v++)
+		sweep->seen[v] = -1;
+	probabilitySweepOrder(sweep, probabilitySweepOrder(sweep, 0, 0), 1);
+	for(int64_t i = 0; i < tileTotal; i++)
+		sweep->position[sweep->order[i]] = i;
+	for(int64_t k = 0; k < countTotal; k++){
+		int64_t *entry = sweep->countTile + k * 8;
+		for(int j = 0; j < sweep->countSize[k]; j++){
+			int64_t p = sweep->position[entry[j]];
+			int i = j;
+			for(; i > 0 && entry[i - 1] > p; i--)
+				entry[i] = entry[i - 1];
+			entry[i] = p;
+		}
+	}
+	
+	// each count holds 4 key bits from its first tile to its last
+	unsigned int used = 0;
+	int open = 0;
+	component->width = 0;
+	sweep->stepStart[0] = 0;
+	for(int64_t i = 0; i < tileTotal; i++){
+		int64_t v = sweep->order[i], e = sweep->stepStart[i];
+		for(int64_t t = sweep->tileCountStart[v]; t < sweep->tileCountStart[v + 1]; t++, e++){
+			int64_t k = sweep->tileCount[t];
+			int j = 0;
+			while(sweep->countTile[k * 8 + j] != i)
+				j++;
+			if(j == 0){
+				if(open == PROBABILITY_SLOTS)
+					return 1;
+				sweep->countSlot[k] = __builtin_ctz(~used);
+				used |= 1u << sweep->countSlot[k];
+				if(++open > component->width)
+					component->width = open;
+			}
+			sweep->stepShift[e] = sweep->countSlot[k] * 4;
+			sweep->stepMines[e] = sweep->countMines[k];
+			sweep->stepAfter[e] = sweep->countSize[k] - j - 1;
+		}
+		sweep->stepStart[i + 1] = e;
+		for(e = sweep->stepStart[i]; e < sweep->stepStart[i + 1]; e++){
+			if(sweep->stepAfter[e] == 0){
+				used &= ~(1u << (sweep->stepShift[e] / 4));
+				open--;
+			}
+		}
+	}
+	return 0;
+}
+
+int64_t probabilitySweepOrder(ProbabilitySweep *sweep, int64_t from, int64_t stamp){ // breadth-first order over shared counts, returning the last tile reached
+	int64_t head = 0, tail = 1;
+	sweep->order[0] = from;
+	sweep->seen[from] = stamp;
+	while(head < tail){
+		int64_t v = sweep->order[head++];
+		for(int64_t t = sweep->tileCountStart[v]; t < sweep->tileCountStart[v + 1]; t++){
+			int64_t k = sweep->tileCount[t];
+			for(int j = 0; j < sweep->countSize[k]; j++){
+				int64_t u = sweep->countTile[k * 8 + j];
+				if(sweep->seen[u] != stamp){
+					sweep->seen[u] = stamp;
+					sweep->order[tail++] = u;
+				}
+			}
+		}
+	}
+	return sweep->order[tail - 1];
+}
+
+int probabilitySweepReserve(ProbabilitySweep *sweep, int64_t states, int width){ // room for states, grown by doubling
+	if(states > sweep->stateCapacity){
+		int64_t capacity = states * 2 > 1024 ? states * 2 : 1024;
+		uint64_t *key = realloc(sweep->key, sizeof(uint64_t) * capacity);
+		if(key == NULL)
+			return -1;
+		sweep->key = key;
+		int64_t *next = realloc(sweep->next, sizeof(int64_t) * 2 * capacity);
+		if(next == NULL)
+			return -1;
+		sweep->next = next;
+		sweep->stateCapacity = capacity;
+	}
+	if(states * width > sweep->valueCapacity){
+		int64_t capacity = states * width * 2 > 4096 ? states * width * 2 : 4096;
+		double *value = realloc(sweep->value, sizeof(double) * capacity);
+		if(value == NULL)
+			return -1;
+		sweep->value = value;
+		unsigned char *support = realloc(sweep->support, capacity);
+		if(support == NULL)
+			return -1;
+		sweep->support = support;
+		sweep->valueCapacity = capacity;
+	}
+	return 0;
+}
+
+int probabilitySweepTable(ProbabilitySweep *sweep, int64_t states){ // an empty table at most half full with states, a power of 2 in size
+	int64_t capacity = 16;
+	while(capacity < states * 2)
+		capacity *= 2;
+	if(capacity > sweep->tableCapacity){
+		int64_t *table = realloc(sweep->table, sizeof(int64_t) * capacity);
+		if(table == NULL)
+			return -1;
+		sweep->table = table;
+	}
+	sweep->tableCapacity = capacity;
+	memset(sweep->table, 0xFF, sizeof(int64_t) * capacity);
+	return 0;
+}
+
+int probabilitySweepBack(ProbabilitySweep *sweep, int64_t size){
+	if(size <= sweep->backCapacity)
+		return 0;
+	for(int b = 0; b < 2; b++){
+		double *back = realloc(sweep->back[b], sizeof(double) * size);
+		if(back == NULL)
+			return -1;
+		sweep->back[b] = back;
+		unsigned char *support = realloc(sweep->backSupport[b], size);
+		if(support == NULL)
+			return -1;
+		sweep->backSupport[b] = support;
+	}
+	sweep->backCapacity = size;
+	return 0;
+}
+
+void probabilitySweepCleanup(ProbabilitySweep *sweep){
+	arenaCleanup(&sweep->arena);
+	free(sweep->key);
+	free(sweep->next);
+	free(sweep->value);
+	free(sweep->support);
+	free(sweep->table);
+	free(sweep->back[0]);
+	free(sweep->back[1]);
+	free(sweep->backSupport[0]);
+	free(sweep->backSupport[1]);
+	probabilitySweepSetup(sweep);
+}
+
+// weight functions
+
+int probabilityCombine(Probability *probability){ // outside weights of every component, from a tree of products and the interior's binomial weights, -1 on failure
+	int64_t left = probability->minesLeft, interior = probability->interior;
+	if(probability->componentTotal == 0){
+		probability->interiorProbability = interior > 0 ? (double)left / interior : 0.;
+		probability->interiorCertain = left == 0 ? PROBABILITY_SAFE : left == interior ? PROBABILITY_MINE : 0;
+		return 0;
+	}
+	
+	// products of node pairs, taken in order until one node holds every component
+	ProbabilityNode *node = probability->node;
+	for(int64_t n = 0; n + 1 < probability->nodeTotal; n += 2){
+		ProbabilityNode *product = &node[probability->nodeTotal];
+		product->child[0] = n;
+		product->child[1] = n + 1;
+		product->outside.value = NULL;
+		product->weight.value = NULL;
+		product->outside.support = product->weight.support = NULL;
+		probability->nodeTotal++;
+		if(probabilityPolyProduct(&product->weight, &node[n].weight, &node[n + 1].weight))
+			return -1;
+	}
+	
+	// the root weighed against the interior: C(interior, left - k) ways to place the rest, untilted, built up a ratio at a time
+	ProbabilityNode *root = &node[probability->nodeTotal - 1];
+	ProbabilityPoly *weight = &root->weight, *outside = &root->outside;
+	outside->low = weight->low;
+	outside->size = weight->size;
+	outside->value = malloc(sizeof(double) * weight->size);
+	outside->support = malloc(weight->size);
+	if(outside->value == NULL || outside->support == NULL)
+		return -1;
+	double logTilt = log(probability->tilt), logWeight = 0., largest = -INFINITY;
+	int interiorSafe = 1, interiorMine = 1;
+	for(int64_t j = 0; j < weight->size; j++){
+		int64_t k = weight->low + j;
+		outside->support[j] = left - k >= 0 && left - k <= interior;
+		if(!outside->support[j]){
+			outside->value[j] = -INFINITY;
+			continue;
+		}
+		if(weight->support[j]){ // the interior takes left - k mines in some layout
+			interiorSafe &= left - k == 0;
+			interiorMine &= left - k == interior;
+		}
+		if(largest > -INFINITY)
+			logWeight += log((double)(left - k + 1) / (interior - left + k));
+		outside->value[j] = logWeight - k * logTilt;
+		if(outside->value[j] > largest)
+			largest = outside->value[j];
+	}
+	if(largest == -INFINITY)
+		return -1;
+	double total = 0., interiorMines = 0.;
+	for(int64_t j = 0; j < weight->size; j++){
+		outside->value[j] = exp(outside->value[j] - largest);
+		total += weight->value[j] * outside->value[j];
+		interiorMines += weight->value[j] * outside->value[j] * (left - weight->low - j);
+	}
+	outside->scale = largest;
+	probability->interiorProbability = interior > 0 ? interiorMines / total / interior : 0.;
+	probability->interiorCertain = interiorSafe ? PROBABILITY_SAFE : interiorMine ? PROBABILITY_MINE : 0;
+	if(probabilityPolyNormalise(outside))
+		return -1;
+	
+	// down the tree, each child weighed against its sibling and everything outside their parent
+	for(int64_t n = probability->nodeTotal - 1; n >= probability->componentTotal; n--){
+		ProbabilityNode *a = &node[node[n].child[0]], *b = &node[node[n].child[1]];
+		if(probabilityPolyOutside(&a->outside, &a->weight, &b->weight, &node[n].outside) || probabilityPolyOutside(&b->outside, &b->weight, &a->weight, &node[n].outside))
+			return -1;
+	}
+	return 0;
+}
+
+int probabilityPolyProduct(ProbabilityPoly *product, ProbabilityPoly *a, ProbabilityPoly *b){ // weights of the two together by their summed mines
+	product->low = a->low + b->low;
+	product->size = a->size + b->size - 1;
+	product->scale = a->scale + b->scale;
+	product->value = calloc(product->size, sizeof(double));
+	product->support = calloc(product->size, 1);
+	if(product->value == NULL || product->support == NULL)
+		return -1;
+	for(int64_t i = 0; i < a->size; i++){
+		for(int64_t j = 0; j < b->size; j++){
+			product->value[i + j] += a->value[i] * b->value[j];
+			product->support[i + j] |= a->support[i] & b->support[j];
+		}
+	}
+	return probabilityPolyNormalise(product);
+}
+
+int probabilityPolyOutside(ProbabilityPoly *outside, ProbabilityPoly *self, ProbabilityPoly *sibling, ProbabilityPoly *parent){ // outside[x] = sum of sibling[y] * parent outside[x + y] over the sibling's mines y
+	outside->low = self->low;
+	outside->size = self->size;
+	outside->scale = sibling->scale + parent->scale;
+	outside->value = calloc(self->size, sizeof(double));
+	outside->support = calloc(self->size, 1);
+	if(outside->value == NULL || outside->support == NULL)
+		return -1;
+	for(int64_t i = 0; i < self->size; i++){
+		for(int64_t j = 0; j < sibling->size; j++){
+			int64_t p = self->low + i + sibling->low + j - parent->low;
+			if(p >= 0 && p < parent->size){
+				outside->value[i] += sibling->value[j] * parent->value[p];
+				outside->support[i] |= sibling->support[j] & parent->support[p];
+			}
+		}
+	}
+	return probabilityPolyNormalise(outside);
+}
+
+int probabilityPolyNormalise(ProbabilityPoly *poly){ // ends no layout reaches trimmed and the largest weight scaled to 1, -1 if every weight is zero
+	int64_t first = 0, last = poly->size - 1;
+	while(first <= last && !poly->support[first])
+		first++;
+	while(last >= first && !poly->support[last])
+		last--;
+	if(first > last)
+		return -1;
+	double largest = 0.;
+	for(int64_t i = first; i <= last; i++)
+		if(poly->value[i] > largest)
+			largest = poly->value[i];
+	if(largest <= 0.)
+		return -1;
+	for(int64_t i = first; i <= last; i++){
+		poly->value[i - first] = poly->value[i] / largest;
+		poly->support[i - first] = poly->support[i];
+	}
+	poly->low += first;
+	poly->size = last - first + 1;
+	poly->scale += log(largest);
+	return 0;
+}
+
+// cleanup functions
+
+void probabilityCleanup(Probability *probability){
+	solverCleanup(&probability->solver);
+	arenaCleanup(&probability->arena);
+	arenaCleanup(&probability->listArena);
+	probabilitySetup(probability);
+}
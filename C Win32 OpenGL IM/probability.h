@@ -0,0 +1,103 @@
+#ifndef PROBABILITY
+#define PROBABILITY
+
+#include <stdint.h>
+
+#include "arena.h"
+#include "board.h"
+#include "solver.h"
+
+#define PROBABILITY_SLOTS 16 // counts a component sweep keeps open at once, 4 bits each of a 64-bit state key
+#define PROBABILITY_BUDGET (1 << 24) // weights one component sweep may hold, 9 bytes each with their support, before the component is estimated
+
+// per-tile certainty bits
+#define PROBABILITY_SAFE 0x01 // no layout agreeing with the board has a mine there
+#define PROBABILITY_MINE 0x02 // every one has
+
+// weights by mine count, log-scaled: exp(scale) * value[k - low]
+typedef struct ProbabilityPoly{
+	int64_t low;
+	int64_t size;
+	double scale;
+	double *value;
+	unsigned char *support; // 1 where some layout has that many mines, exact where a weight may round to 0
+}ProbabilityPoly;
+
+// frontier tiles joined through shared counts, with no count reaching another component
+typedef struct ProbabilityComponent{
+	int64_t tileFirst; // in Probability.tile
+	int64_t tileTotal;
+	int64_t countFirst; // in Probability.count
+	int64_t countTotal;
+	int64_t states; // sweep states over every tile
+	int width; // most counts open at once in the sweep
+	int estimated; // 1 where the sweep passed PROBABILITY_SLOTS or PROBABILITY_BUDGET, its tiles then weighed as interior ones
+}ProbabilityComponent;
+
+// node of the tree combining component weights, the first componentTotal being the components themselves
+typedef struct ProbabilityNode{
+	ProbabilityPoly weight; // layouts of the node's tiles by mines, each mine weighted by Probability.tilt
+	ProbabilityPoly outside; // weight of every other tile, interior included, by the node's mines
+	int64_t child[2]; // -1 for components
+}ProbabilityNode;
+
+// per-tile mine probabilities from what a player sees, over every mine layout agreeing with the counts, flags and mine total
+typedef struct Probability{
+	Solver solver; // certain tiles, settled before the frontier is split
+	Arena arena; // probability and frontierOf, kept across runs and only grown
+	Arena listArena; // frontier lists, components and nodes, sized by the frontier of each run
+	int64_t totalTiles;
+	double *probability; // per tile: chance of a mine, 0 for revealed tiles and 1 for flags
+	unsigned char *certain; // per tile: PROBABILITY_SAFE or PROBABILITY_MINE where the layouts all agree, found from which layouts exist rather than from probability
+	int threads; // component sweep threads, the calling thread included
+	
+	// frontier: undecided hidden tiles next to a revealed count, grouped by component
+	int64_t *frontierOf; // per tile: its place in tile, -1 off the frontier
+	int64_t *tile;
+	int64_t tileTotal;
+	int64_t *count; // revealed counts next to frontier tiles, grouped by component
+	int64_t countTotal;
+	ProbabilityComponent *component;
+	int64_t componentTotal;
+	ProbabilityNode *node;
+	int64_t nodeTotal;
+	
+	// global mine count
+	int64_t interior; // undecided hidden tiles off the frontier
+	int64_t minesLeft; // mines neither flagged nor deduced
+	double tilt; // per-mine factor keeping component weights near the interior's, so products stay in range
+	double interiorProbability;
+	unsigned char interiorCertain;
+	
+	// counters of the last run
+	int64_t largest; // tiles in the largest component
+	int widest; // most counts open at once in any sweep
+	int64_t states; // sweep states over every component
+	int64_t estimated; // tiles of components past the sweep limits, given the interior's probability with their counts left out
+}Probability;
+
+// setup
+void probabilitySetup(Probability *probability);
+int probabilityResize(Probability *probability, int64_t totalTiles);
+
+// probabilities
+int probabilityRun(Probability *probability, Game *game);
+
+// frontier
+int probabilityFrontier(Probability *probability, Game *game);
+int64_t probabilityRoot(int64_t *parent, int64_t p);
+
+// components
+int probabilitySolve(Probability *probability, Game *game, int marginals);
+void probabilityEstimate(Probability *probability);
+
+// weights
+int probabilityCombine(Probability *probability);
+int probabilityPolyProduct(ProbabilityPoly *product, ProbabilityPoly *a, ProbabilityPoly *b);
+int probabilityPolyOutside(ProbabilityPoly *outside, ProbabilityPoly *self, ProbabilityPoly *sibling, ProbabilityPoly *parent);
+int probabilityPolyNormalise(ProbabilityPoly *poly);
+
+// cleanup
+void probabilityCleanup(Probability *probability);
+
+#endif
@@ -0,0 +1,78 @@
+#include <stdlib.h>
+
+#include "random.h"
+
+// setup functions
+
+void randomSeed(Random *random, uint64_t seed){
+	
+	// expand the seed with splitmix64, which never yields the all-zero xoshiro state
+	for(int i = 0; i < 4; i++){
+		seed += 0x9E3779B97F4A7C15ull;
+		uint64_t z = seed;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		random->state[i] = z ^ (z >> 31);
+	}
+	if(random->next == randomLibc)
+		srand((unsigned int)seed);
+}
+
+// generator functions
+
+uint64_t randomXoshiro(Random *random){ // xoshiro256**
+	uint64_t *s = random->state;
+	uint64_t result = s[1] * 5;
+	result = ((result << 7) | (result >> 57)) * 9;
+	uint64_t t = s[1] << 17;
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = (s[3] << 45) | (s[3] >> 19);
+	return result;
+}
+
+uint64_t randomLibc(Random *random){ // rand(), 15 bits per call so that any RAND_MAX is covered
+	(void)random; // rand() keeps its own state, the parameter only fits Random.next
+	uint64_t result = 0;
+	for(int i = 0; i < 5; i++)
+		result = (result << 15) | (rand() & 0x7FFF);
+	return result;
+}
+
+// draw functions
+
+int randomBelow(Random *random, int bound){ // unbiased multiply-shift reduction of the high 32 bits
+	uint64_t m = (random->next(random) >> 32) * (uint64_t)bound;
+	uint32_t low = (uint32_t)m;
+	if(low < (uint32_t)bound){
+		uint32_t threshold = -(uint32_t)bound % (uint32_t)bound;
+		while(low < threshold){
+			m = (random->next(random) >> 32) * (uint64_t)bound;
+			low = (uint32_t)m;
+		}
+	}
+	return (int)(m >> 32);
+}
+
+int64_t randomBelow64(Random *random, int64_t bound){ // randomBelow for bounds past 32 bits, rejecting draws beyond the bound's bit mask
+	if(bound <= INT32_MAX)
+		return randomBelow(random, (int)bound);
+	uint64_t mask = (uint64_t)bound - 1;
+	for(int shift = 1; shift < 64; shift *= 2)
+		mask |= mask >> shift;
+	uint64_t draw;
+	do draw = random->next(random) & mask; while(draw >= (uint64_t)bound);
+	return (int64_t)draw;
+}
+
+// hash functions
+
+uint64_t randomHash(uint64_t key, uint64_t counter){ // splitmix64 finaliser of the keyed counter
+	uint64_t z = key ^ (counter * 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
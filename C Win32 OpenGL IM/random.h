@@ -0,0 +1,25 @@
+#ifndef RANDOM
+#define RANDOM
+
+#include <stdint.h>
+
+typedef struct Random{
+	uint64_t state[4];
+	uint64_t (*next)(struct Random *random); // generator in use, randomXoshiro unless another is plugged in
+}Random;
+
+// setup
+void randomSeed(Random *random, uint64_t seed);
+
+// generators
+uint64_t randomXoshiro(Random *random);
+uint64_t randomLibc(Random *random);
+
+// draws
+int randomBelow(Random *random, int bound);
+int64_t randomBelow64(Random *random, int64_t bound);
+
+// counter-based hashing, for values that must be recomputable in any order without stored state
+uint64_t randomHash(uint64_t key, uint64_t counter);
+
+#endif
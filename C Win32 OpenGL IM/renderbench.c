@@ -0,0 +1,235 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+#include "graphics.h"
+#include "game.h"
+
+#define RENDER_SIZE 1024 // side of the offscreen surface in pixels
+#define RENDER_IMMEDIATE_TILES 1000000 // largest board drawn the old way, which takes seconds a frame past this
+#define RENDER_VERTEX_TILES 16000000 // largest board drawn from a vertex array, 64 bytes a tile
+
+// offscreen GL context, on the software rasteriser when no GPU is present
+typedef struct RenderContext{
+	EGLDisplay display;
+	EGLSurface surface;
+	EGLContext context;
+}RenderContext;
+
+// context
+int renderSetup(RenderContext *render);
+void renderCleanup(RenderContext *render);
+
+// frames
+int renderDrawSetup(Game *game, DrawData *draw, unsigned int texture, int quadTiles);
+double renderTime();
+double renderFrames(DrawData *draw, void (*drawFunc)(Game *game, DrawData *draw), Game *game, int frames);
+void renderBatched(Game *game, DrawData *draw);
+void renderImmediate(Game *game, DrawData *draw);
+double renderFlags(Game *game, DrawData *draw, int frames);
+int renderCompare(Game *game, DrawData *draw, void (*drawFunc)(Game *game, DrawData *draw), DrawData *referenceDraw, void (*referenceFunc)(Game *game, DrawData *draw), unsigned char *pixels, unsigned char *reference);
+
+// context functions
+
+int renderSetup(RenderContext *render){
+	
+	// surfaceless display where the platform is offered, so no window system is needed
+	PFNEGLGETPLATFORMDISPLAYEXTPROC platformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+	render->display = platformDisplay != NULL ? platformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL) : EGL_NO_DISPLAY;
+	if(render->display == EGL_NO_DISPLAY)
+		render->display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+	EGLint major, minor;
+	if(render->display == EGL_NO_DISPLAY || !eglInitialize(render->display, &major, &minor))
+		return -1;
+	
+	// desktop OpenGL on an offscreen buffer, as the window's context
+	EGLint configAttributes[] = {
+		EGL_SURFACE_TYPE, EGL_PBUFFER_BIT, EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+		EGL_RED_SIZE, 8, EGL_GREEN_SIZE, 8, EGL_BLUE_SIZE, 8, EGL_DEPTH_SIZE, 16, EGL_NONE };
+	EGLint surfaceAttributes[] = { EGL_WIDTH, RENDER_SIZE, EGL_HEIGHT, RENDER_SIZE, EGL_NONE };
+	EGLConfig config;
+	EGLint configTotal;
+	if(!eglChooseConfig(render->display, configAttributes, &config, 1, &configTotal) || configTotal < 1)
+		return -1;
+	render->surface = eglCreatePbufferSurface(render->display, config, surfaceAttributes);
+	if(render->surface == EGL_NO_SURFACE || !eglBindAPI(EGL_OPENGL_API))
+		return -1;
+	render->context = eglCreateContext(render->display, config, EGL_NO_CONTEXT, NULL);
+	if(render->context == EGL_NO_CONTEXT || !eglMakeCurrent(render->display, render->surface, render->surface, render->context))
+		return -1;
+	return 0;
+}
+
+void renderCleanup(RenderContext *render){
+	eglMakeCurrent(render->display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+	eglDestroyContext(render->display, render->context);
+	eglDestroySurface(render->display, render->surface);
+	eglTerminate(render->display);
+}
+
+// frame functions
+
+int renderDrawSetup(Game *game, DrawData *draw, unsigned int texture, int quadTiles){ // draw data filling the surface, on the path quadTiles picks
+	if(drawSetup(game, draw, texture))
+		return -1;
+	draw->quadTiles = quadTiles;
+	draw->windowSize.x = draw->windowSize.y = RENDER_SIZE;
+	if(drawRetile(game, draw))
+		return -1;
+	game->dirtyAll = 1; // each draw data takes the whole board, as the game's dirty list only serves one
+	drawUpdate(game, draw);
+	return 0;
+}
+
+double renderTime(){
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+double renderFrames(DrawData *draw, void (*drawFunc)(Game *game, DrawData *draw), Game *game, int frames){ // seconds per frame
+	double t = renderTime();
+	for(int f = 0; f < frames; f++){
+		screenClear();
+		drawFunc(game, draw);
+		glFinish();
+	}
+	return (renderTime() - t) / frames;
+}
+
+void renderBatched(Game *game, DrawData *draw){
+	drawGame(draw);
+}
+
+void renderImmediate(Game *game, DrawData *draw){ // drawGame as it was, one drawTexture per tile
+	for(int64_t t = 0; t < draw->n; t++){
+		float x = (float)(t % game->width + .5f - .5f * game->width) * 2.f * draw->tileSize.x;
+		float y = (float)(t / game->width + .5f - .5f * game->height) * 2.f * draw->tileSize.y;
+		drawTexture(
+			x, y, draw->tileSize.x, draw->tileSize.y,
+			draw->texture, draw->tileUVLo[draw->value[t]].x, draw->tileUVHi[draw->value[t]].x, draw->tileUVHi[draw->value[t]].y, draw->tileUVLo[draw->value[t]].y);
+	}
+}
+
+double renderFlags(Game *game, DrawData *draw, int frames){ // seconds for a flag toggle, its update and a frame
+	int64_t hidden = 0;
+	while(gameMask(game, hidden) != 1)
+		hidden++;
+	double t = renderTime();
+	for(int f = 0; f < frames; f++){
+		gameFlag(game, hidden);
+		drawUpdate(game, draw);
+		screenClear();
+		drawGame(draw);
+		glFinish();
+	}
+	return (renderTime() - t) / frames;
+}
+
+int renderCompare(Game *game, DrawData *draw, void (*drawFunc)(Game *game, DrawData *draw), DrawData *referenceDraw, void (*referenceFunc)(Game *game, DrawData *draw), unsigned char *pixels, unsigned char *reference){ // pixels differing between two paths
+	screenClear();
+	referenceFunc(game, referenceDraw);
+	glReadPixels(0, 0, RENDER_SIZE, RENDER_SIZE, GL_RGB, GL_UNSIGNED_BYTE, reference);
+	screenClear();
+	drawFunc(game, draw);
+	glReadPixels(0, 0, RENDER_SIZE, RENDER_SIZE, GL_RGB, GL_UNSIGNED_BYTE, pixels);
+	int differing = 0;
+	for(int p = 0; p < RENDER_SIZE * RENDER_SIZE; p++)
+		differing += memcmp(pixels + p * 3, reference + p * 3, 3) != 0;
+	return differing;
+}
+
+int main(int argc, char **argv){
+	setvbuf(stdout, NULL, _IOLBF, 0);
+	RenderContext render;
+	if(renderSetup(&render)){
+		printf("no OpenGL context\n");
+		return 1;
+	}
+	printf("%s, OpenGL %s, %dx%d pixels\n", glGetString(GL_RENDERER), glGetString(GL_VERSION), RENDER_SIZE, RENDER_SIZE);
+	screenSetup();
+	screenResize(RENDER_SIZE, RENDER_SIZE);
+	unsigned int texture = textureSetup("textures.bmp");
+	unsigned char *pixels = malloc(RENDER_SIZE * RENDER_SIZE * 3);
+	unsigned char *reference = malloc(RENDER_SIZE * RENDER_SIZE * 3);
+	if(pixels == NULL || reference == NULL){
+		printf("allocation failure\n");
+		return 1;
+	}
+	
+	int sizes[6][3] = { { 30, 20, 99 }, { 300, 300, 13500 }, { 1000, 1000, 150000 }, { 2000, 2000, 600000 }, { 4000, 4000, 2400000 }, { 8000, 8000, 9600000 } };
+	for(int s = 0; s < 6; s++){
+		int width = sizes[s][0], height = sizes[s][1], mines = sizes[s][2];
+		int start = width / 2 + height / 2 * width;
+		int frames = width * height <= 100000 ? 20 : width * height <= 1000000 ? 3 : 1;
+		int immediate = width * height <= RENDER_IMMEDIATE_TILES;
+		int vertex = width * height <= RENDER_VERTEX_TILES;
+		printf("%dx%d, %d mines\n", width, height, mines);
+		
+		// a board opened from the centre, drawn to fill the surface from a vertex array and as one quad
+		Game game;
+		DrawData tiles, quad;
+		if(gameBoardSetup(&game, width, height, mines)){
+			printf("  allocation failure\n");
+			return 1;
+		}
+		gameSeed(&game, 7);
+		gameStart(&game, start);
+		gameTileReveal(start, &game);
+		if((vertex && renderDrawSetup(&game, &tiles, texture, INT_MAX)) || renderDrawSetup(&game, &quad, texture, 0)){
+			printf("  allocation failure\n");
+			return 1;
+		}
+		if(!quad.quadBoard)
+			printf("  no single-quad path: %s\n", quad.program == 0 ? "shader unsupported" : "board past the texture size limit");
+		
+		// whole frames on each path
+		double seconds;
+		if(immediate){
+			seconds = renderFrames(&tiles, renderImmediate, &game, frames);
+			printf("  %-40s %10.3f ms %10.1f frames/s\n", "frame, drawTexture per tile", seconds * 1e3, 1. / seconds);
+		}
+		if(vertex){
+			seconds = renderFrames(&tiles, renderBatched, &game, frames);
+			printf("  %-40s %10.3f ms %10.1f frames/s\n", "frame, one vertex array", seconds * 1e3, 1. / seconds);
+		}
+		if(quad.quadBoard){
+			seconds = renderFrames(&quad, renderBatched, &game, frames);
+			printf("  %-40s %10.3f ms %10.1f frames/s\n", "frame, one quad over a state texture", seconds * 1e3, 1. / seconds);
+		}
+		
+		// a flag toggle then a redraw, rebuilding only the changed tile's corners or texture row
+		if(vertex)
+			printf("  %-40s %10.3f ms\n", "flag, update and frame, vertex array", renderFlags(&game, &tiles, frames) * 1e3);
+		if(quad.quadBoard){
+			printf("  %-40s %10.3f ms\n", "flag, update and frame, state texture", renderFlags(&game, &quad, frames) * 1e3);
+			game.dirtyAll = 1;
+			drawUpdate(&game, &quad);
+		}
+		
+		// the old path against the vertex array, which should match exactly, and the vertex array against the quad
+		if(immediate){
+			int differing = renderCompare(&game, &tiles, renderBatched, &tiles, renderImmediate, pixels, reference);
+			printf("  vertex array pixels %s (%d differ)\n", differing == 0 ? "match" : "DO NOT MATCH", differing);
+		}
+		if(vertex && quad.quadBoard){
+			int differing = renderCompare(&game, &quad, renderBatched, &tiles, renderBatched, pixels, reference);
+			printf("  state texture pixels %s (%d differ)\n", differing == 0 ? "match" : "DO NOT MATCH", differing);
+		}
+		
+		gameBoardCleanup(&game);
+		if(vertex)
+			drawCleanup(&tiles);
+		drawCleanup(&quad);
+	}
+	
+	free(pixels);
+	free(reference);
+	renderCleanup(&render);
+	return 0;
+}
@@ -0,0 +1,227 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "solver.h"
+
+#define SOLVER_BIT(dx, dy) ((uint64_t)1 << (((dy) + SOLVER_FRAME / 2) * SOLVER_FRAME + (dx) + SOLVER_FRAME / 2))
+
+// setup functions
+
+void solverSetup(Solver *solver){
+	arenaSetup(&solver->arena);
+	solver->totalTiles = 0;
+	solver->state = NULL;
+	solver->work = solver->pair = solver->safe = solver->mine = NULL;
+	solver->workTotal = solver->pairTotal = solver->safeTotal = solver->mineTotal = 0;
+}
+
+int solverResize(Solver *solver, int64_t totalTiles){
+	if(solver->state != NULL && solver->totalTiles == totalTiles)
+		return 0;
+	size_t stateSize = sizeof(unsigned char) * totalTiles;
+	size_t listSize = sizeof(int64_t) * totalTiles;
+	if(arenaReserve(&solver->arena, arenaSize(stateSize) + arenaSize(listSize) * 4) < 0)
+		return -1;
+	arenaReset(&solver->arena);
+	solver->state = arenaTake(&solver->arena, stateSize);
+	solver->work = arenaTake(&solver->arena, listSize);
+	solver->pair = arenaTake(&solver->arena, listSize);
+	solver->safe = arenaTake(&solver->arena, listSize);
+	solver->mine = arenaTake(&solver->arena, listSize);
+	solver->totalTiles = totalTiles;
+	return 0;
+}
+
+// solving functions
+
+int64_t solverRun(Solver *solver, Game *game){ // tiles deduced, -1 on allocation failure
+	if(game->trackFrontier)
+		gameFrontierUpdate(game);
+	int64_t deduced = solverScan(solver, game);
+	
+	// a kept frontier's touched constraints are covered by the whole board
+	if(deduced >= 0 && game->trackFrontier && !game->frontierStale)
+		gameTouchedReset(game);
+	return deduced;
+}
+
+int64_t solverScan(Solver *solver, Game *game){ // as solverRun, leaving a kept frontier and its touched constraints to their own solver; -1 on allocation failure
+	if(solverResize(solver, game->totalTiles))
+		return -1;
+	memset(solver->state, 0, game->totalTiles);
+	solver->workTotal = solver->pairTotal = solver->safeTotal = solver->mineTotal = 0;
+	
+	// every revealed count starts in the single-point list, moving to the subset list while it has unknowns left
+	for(int64_t t = 0; t < game->totalTiles; t++){
+		if(gameMask(game, t) == 0 && gameTile(game, t) > 0){
+			solver->state[t] = SOLVER_QUEUED;
+			solver->work[solver->workTotal++] = t;
+		}
+	}
+	solverDeduce(solver, game);
+	return solver->safeTotal + solver->mineTotal;
+}
+
+int64_t solverUpdate(Solver *solver, Game *game){ // tiles newly deduced from the constraints touched since the last run, earlier deductions kept in state; as solverRun without a kept frontier or after a rebuild
+	if(game->trackFrontier)
+		gameFrontierUpdate(game);
+	if(!game->trackFrontier || game->frontierStale || game->frontierAll || solver->state == NULL || solver->totalTiles != game->totalTiles)
+		return solverRun(solver, game);
+	solver->workTotal = solver->pairTotal = solver->safeTotal = solver->mineTotal = 0;
+	
+	// only counts whose neighbours changed can deduce anything new, the rest were drained by the last run
+	for(int64_t i = 0; i < game->touchedTotal; i++){
+		int64_t t = game->touched[i];
+		if(game->frontierMark[t] & FRONTIER_ON){
+			solver->state[t] |= SOLVER_QUEUED;
+			solver->work[solver->workTotal++] = t;
+		}
+	}
+	gameTouchedReset(game);
+	solverDeduce(solver, game);
+	return solver->safeTotal + solver->mineTotal;
+}
+
+void solverDeduce(Solver *solver, Game *game){ // drains the work lists
+	solver->constraints = solver->subsetChecks = 0;
+	solver->rounds = 0;
+	
+	// single-point deductions until none are left, then one subset check at a time, which may open more of them
+	int subsetting = 0;
+	while(solver->workTotal > 0 || solver->pairTotal > 0){
+		if(solver->workTotal > 0){
+			if(subsetting){
+				solver->rounds++;
+				subsetting = 0;
+			}
+			int64_t target = solver->work[--solver->workTotal];
+			solver->state[target] &= ~SOLVER_QUEUED;
+			solver->constraints++;
+			solverSingle(solver, game, target);
+		}
+		else{
+			subsetting = 1;
+			int64_t target = solver->pair[--solver->pairTotal];
+			solver->state[target] &= ~SOLVER_PAIRED;
+			solverSubset(solver, game, target);
+		}
+	}
+	solver->rounds++;
+}
+
+// solver operation functions
+
+uint64_t solverUnknown(Solver *solver, Game *game, int x, int y, int frameX, int frameY, int *remaining){ // unknown neighbours of (x, y) as bits of the frame around (frameX, frameY)
+	int count = gameTile(game, (int64_t)y * game->width + x);
+	uint64_t frame = 0;
+	for(int dy = -1; dy <= 1; dy++){
+		if(y + dy < 0 || y + dy >= game->height) continue;
+		for(int dx = -1; dx <= 1; dx++){
+			if(x + dx < 0 || x + dx >= game->width || (dx == 0 && dy == 0)) continue;
+			int64_t n = (int64_t)(y + dy) * game->width + x + dx;
+			int mask = gameMask(game, n);
+			if(mask == 2 || solver->state[n] & SOLVER_MINE)
+				count--;
+			else if(mask == 1 && !(solver->state[n] & SOLVER_SAFE))
+				frame |= SOLVER_BIT(x + dx - frameX, y + dy - frameY);
+		}
+	}
+	*remaining = count;
+	return frame;
+}
+
+void solverMarkFrame(Solver *solver, Game *game, uint64_t frame, int frameX, int frameY, int mine){
+	for(int b = 0; frame != 0; b++, frame >>= 1)
+		if(frame & 1)
+			solverMark(solver, game, (int64_t)(frameY + b / SOLVER_FRAME - SOLVER_FRAME / 2) * game->width + frameX + b % SOLVER_FRAME - SOLVER_FRAME / 2, mine);
+}
+
+void solverMark(Solver *solver, Game *game, int64_t target, int mine){
+	solver->state[target] |= mine ? SOLVER_MINE : SOLVER_SAFE;
+	if(mine)
+		solver->mine[solver->mineTotal++] = target;
+	else
+		solver->safe[solver->safeTotal++] = target;
+	
+	// the counts around it have one unknown fewer
+	int64_t pos[8];
+	gameGetConnectedTiles(target, game, (int64_t*)&pos);
+	for(int p = 0; p < 8; p++)
+		if(pos[p] >= 0 && gameMask(game, pos[p]) == 0 && gameTile(game, pos[p]) > 0)
+			solverPush(solver, pos[p]);
+}
+
+void solverPush(Solver *solver, int64_t target){
+	if(!(solver->state[target] & SOLVER_QUEUED)){
+		solver->state[target] |= SOLVER_QUEUED;
+		solver->work[solver->workTotal++] = target;
+	}
+	if(!(solver->state[target] & SOLVER_PAIRED)){
+		solver->state[target] |= SOLVER_PAIRED;
+		solver->pair[solver->pairTotal++] = target;
+	}
+}
+
+int solverSingle(Solver *solver, Game *game, int64_t target){ // 1 if the count settled its unknowns
+	int y = gameRow(game, target);
+	int x = (int)(target - (int64_t)y * game->width);
+	int remaining;
+	uint64_t unknown = solverUnknown(solver, game, x, y, x, y, &remaining);
+	int total = __builtin_popcountll(unknown);
+	if(total == 0)
+		return 0;
+	if(remaining != 0 && remaining != total){
+		if(!(solver->state[target] & SOLVER_PAIRED)){
+			solver->state[target] |= SOLVER_PAIRED;
+			solver->pair[solver->pairTotal++] = target;
+		}
+		return 0;
+	}
+	solverMarkFrame(solver, game, unknown, x, y, remaining != 0);
+	return 1;
+}
+
+int solverSubset(Solver *solver, Game *game, int64_t target){ // 1 if any count within 2 tiles settled the difference of their unknowns
+	int y = gameRow(game, target);
+	int x = (int)(target - (int64_t)y * game->width);
+	int remaining;
+	uint64_t unknown = solverUnknown(solver, game, x, y, x, y, &remaining);
+	int settled = 0;
+	for(int dy = -2; dy <= 2 && unknown != 0; dy++){
+		if(y + dy < 0 || y + dy >= game->height) continue;
+		for(int dx = -2; dx <= 2 && unknown != 0; dx++){
+			if(x + dx < 0 || x + dx >= game->width || (dx == 0 && dy == 0)) continue;
+			int64_t other = (int64_t)(y + dy) * game->width + x + dx;
+			if(gameMask(game, other) != 0 || gameTile(game, other) <= 0) continue;
+			int otherRemaining;
+			uint64_t otherUnknown = solverUnknown(solver, game, x + dx, y + dy, x, y, &otherRemaining);
+			if(otherUnknown == 0 || otherUnknown == unknown) continue;
+			solver->subsetChecks++;
+			
+			// the larger set holds the smaller one's mines, and the difference holds the rest
+			uint64_t difference;
+			int mines;
+			if((unknown & ~otherUnknown) == 0){
+				difference = otherUnknown & ~unknown;
+				mines = otherRemaining - remaining;
+			}
+			else if((otherUnknown & ~unknown) == 0){
+				difference = unknown & ~otherUnknown;
+				mines = remaining - otherRemaining;
+			}
+			else continue;
+			if(mines != 0 && mines != __builtin_popcountll(difference)) continue;
+			solverMarkFrame(solver, game, difference, x, y, mines != 0);
+			unknown = solverUnknown(solver, game, x, y, x, y, &remaining);
+			settled = 1;
+		}
+	}
+	return settled;
+}
+
+// cleanup functions
+
+void solverCleanup(Solver *solver){
+	arenaCleanup(&solver->arena);
+	solverSetup(solver);
+}
@@ -0,0 +1,62 @@
+#ifndef SOLVER
+#define SOLVER
+
+#include <stdint.h>
+
+#include "arena.h"
+#include "board.h"
+
+// per-tile solver state bits
+#define SOLVER_SAFE 0x01 // deduced safe
+#define SOLVER_MINE 0x02 // deduced mine
+#define SOLVER_QUEUED 0x04 // in the single-point work list
+#define SOLVER_PAIRED 0x08 // in the subset work list
+
+#define SOLVER_FRAME 7 // side of the window around a constraint that holds its unknowns and those of constraints up to 2 away
+
+// deductions from what a player sees: revealed counts (mask 0) and flags (mask 2, taken as mines)
+typedef struct Solver{
+	Arena arena; // state and every list below, kept across runs and only grown
+	int64_t totalTiles;
+	unsigned char *state;
+	
+	// work lists of revealed tiles whose unknown neighbours changed
+	int64_t *work; // single-point: all unknowns safe, or all mines
+	int64_t workTotal;
+	int64_t *pair; // subset: unknowns of one count inside another's
+	int64_t pairTotal;
+	
+	// results, hidden unflagged tiles in the order they were deduced by the last run or update
+	int64_t *safe;
+	int64_t safeTotal;
+	int64_t *mine;
+	int64_t mineTotal;
+	
+	// counters of the last run
+	long long constraints; // revealed tiles examined for single-point deductions
+	long long subsetChecks; // constraint pairs compared
+	int rounds; // passes of single-point deductions, a new one starting each time a subset check settles tiles
+}Solver;
+
+// setup
+void solverSetup(Solver *solver);
+int solverResize(Solver *solver, int64_t totalTiles);
+
+// solving
+int64_t solverRun(Solver *solver, Game *game);
+int64_t solverScan(Solver *solver, Game *game);
+int64_t solverUpdate(Solver *solver, Game *game);
+void solverDeduce(Solver *solver, Game *game);
+
+// solver operations
+uint64_t solverUnknown(Solver *solver, Game *game, int x, int y, int frameX, int frameY, int *remaining);
+void solverMarkFrame(Solver *solver, Game *game, uint64_t frame, int frameX, int frameY, int mine);
+void solverMark(Solver *solver, Game *game, int64_t target, int mine);
+void solverPush(Solver *solver, int64_t target);
+int solverSingle(Solver *solver, Game *game, int64_t target);
+int solverSubset(Solver *solver, Game *game, int64_t target);
+
+// cleanup
+void solverCleanup(Solver *solver);
+
+#endif
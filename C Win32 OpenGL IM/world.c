@@ -0,0 +1,402 @@
+#include <stdlib.h>
+
+#include "world.h"
+
+// setup functions
+
+int worldSetup(World *world, uint64_t seed, double density){
+	world->table = NULL;
+	world->revealQueue = NULL;
+	world->recent = NULL;
+	world->spill = NULL;
+	world->record = NULL;
+	if(density < WORLD_DENSITY_MIN || density >= 1.)
+		return -1;
+	world->seed = seed;
+	world->threshold = (uint64_t)(density * 18446744073709551616.);
+	world->tableSize = 64;
+	world->chunkTotal = 0;
+	world->table = calloc(world->tableSize, sizeof(WorldChunk*));
+	world->queueCapacity = WORLD_CHUNK * WORLD_CHUNK;
+	world->revealQueue = malloc(sizeof(int32_t) * 2 * world->queueCapacity);
+	world->chunkLimit = 0;
+	world->newest = NULL;
+	world->oldest = NULL;
+	world->recordSize = 0;
+	world->recordTotal = 0;
+	world->hits = world->misses = world->evictions = 0;
+	world->spillWrites = world->spillReads = 0;
+	world->revealed = 0;
+	world->state = 1;
+	if(world->table == NULL || world->revealQueue == NULL)
+		return -1;
+	return 0;
+}
+
+int worldSession(World *world, int chunkLimit, const char *path){ // path NULL for a temporary spill file
+	if(chunkLimit < 1 || world->spill != NULL)
+		return -1;
+	world->spill = path == NULL ? tmpfile() : fopen(path, "w+b");
+	world->recordSize = 64;
+	world->record = malloc(sizeof(WorldRecord) * world->recordSize);
+	if(world->spill == NULL || world->record == NULL)
+		return -1;
+	for(int r = 0; r < world->recordSize; r++)
+		world->record[r].record = -1;
+	world->chunkLimit = chunkLimit;
+	return 0;
+}
+
+// move functions
+
+void worldSelect(World *world, int32_t x, int32_t y){
+	if(world->state != 1 || worldMask(world, x, y) != 1)
+		return;
+	if(worldTile(world, x, y) == -1){ // game lost
+		*worldCell(world, x, y) &= CELL_TILE;
+		world->state = 2;
+	}
+	else
+		worldTileReveal(world, x, y);
+}
+
+void worldFlag(World *world, int32_t x, int32_t y){
+	unsigned char *cell = worldCell(world, x, y);
+	if(cell == NULL)
+		return;
+	int mask = *cell >> CELL_MASK_SHIFT;
+	if(mask == 1 || mask == 2)
+		*cell = (*cell & CELL_TILE) | ((3 - mask) << CELL_MASK_SHIFT);
+}
+
+// world operation functions
+
+uint64_t worldKey(int32_t x, int32_t y){
+	return ((uint64_t)(uint32_t)y << 32) | (uint32_t)x;
+}
+
+int worldIsMine(World *world, int32_t x, int32_t y){
+	if(x >= -1 && x <= 1 && y >= -1 && y <= 1)
+		return 0;
+	return randomHash(world->seed, worldKey(x, y)) < world->threshold;
+}
+
+WorldChunk *worldChunk(World *world, int32_t cx, int32_t cy){
+	WorldChunk *chunk = world->recent;
+	if(chunk != NULL && chunk->cx == cx && chunk->cy == cy){
+		world->hits++;
+		return chunk;
+	}
+	
+	// probe from the hashed coordinate
+	uint64_t key = worldKey(cx, cy);
+	int slot = (int)(randomHash(0, key) & (world->tableSize - 1));
+	while((chunk = world->table[slot]) != NULL){
+		if(chunk->cx == cx && chunk->cy == cy){
+			world->hits++;
+			worldUse(world, chunk);
+			return chunk;
+		}
+		slot = (slot + 1) & (world->tableSize - 1);
+	}
+	
+	// not resident: make room within the session limit, reusing the evicted chunk's memory
+	world->misses++;
+	chunk = NULL;
+	while(world->chunkLimit > 0 && world->chunkTotal >= world->chunkLimit){
+		free(chunk);
+		chunk = worldEvict(world);
+		if(chunk == NULL)
+			return NULL;
+	}
+	
+	// keep the table at most half full
+	if((world->chunkTotal + 1) * 2 > world->tableSize && worldGrow(world)){
+		free(chunk);
+		return NULL;
+	}
+	slot = (int)(randomHash(0, key) & (world->tableSize - 1));
+	while(world->table[slot] != NULL)
+		slot = (slot + 1) & (world->tableSize - 1);
+	
+	// generate the chunk, then bring back the mask bits it had when last evicted
+	if(chunk == NULL)
+		chunk = malloc(sizeof(WorldChunk));
+	if(chunk == NULL)
+		return NULL;
+	chunk->cx = cx;
+	chunk->cy = cy;
+	chunk->newer = chunk->older = NULL;
+	worldGenerate(world, chunk);
+	if(world->spill != NULL && worldRestore(world, chunk)){
+		free(chunk);
+		return NULL;
+	}
+	world->table[slot] = chunk;
+	world->chunkTotal++;
+	worldUse(world, chunk);
+	return chunk;
+}
+
+void worldGenerate(World *world, WorldChunk *chunk){
+	
+	// mines of the chunk and the ring of cells around it, recomputed from the hash of each coordinate
+	int s = WORLD_CHUNK + 2;
+	unsigned char mine[(WORLD_CHUNK + 2) * (WORLD_CHUNK + 2)];
+	int32_t left = chunk->cx * WORLD_CHUNK - 1;
+	int32_t top = chunk->cy * WORLD_CHUNK - 1;
+	for(int y = 0; y < s; y++)
+		for(int x = 0; x < s; x++)
+			mine[y * s + x] = worldIsMine(world, left + x, top + y);
+	
+	// neighbour counts, every cell hidden
+	for(int y = 0; y < WORLD_CHUNK; y++){
+		unsigned char *above = mine + y * s;
+		unsigned char *row = above + s;
+		unsigned char *below = row + s;
+		unsigned char *cell = chunk->cell + y * WORLD_CHUNK;
+		for(int x = 0; x < WORLD_CHUNK; x++){
+			int i = x + 1;
+			int count = above[i - 1] + above[i] + above[i + 1] + row[i - 1] + row[i + 1] + below[i - 1] + below[i] + below[i + 1];
+			cell[x] = (1 << CELL_MASK_SHIFT) | (row[i] ? CELL_MINE : count);
+		}
+	}
+}
+
+int worldGrow(World *world){
+	WorldChunk **old = world->table;
+	int oldSize = world->tableSize;
+	WorldChunk **table = calloc(oldSize * 2, sizeof(WorldChunk*));
+	if(table == NULL)
+		return -1;
+	world->table = table;
+	world->tableSize = oldSize * 2;
+	for(int o = 0; o < oldSize; o++){
+		if(old[o] == NULL) continue;
+		int slot = (int)(randomHash(0, worldKey(old[o]->cx, old[o]->cy)) & (world->tableSize - 1));
+		while(table[slot] != NULL)
+			slot = (slot + 1) & (world->tableSize - 1);
+		table[slot] = old[o];
+	}
+	free(old);
+	return 0;
+}
+
+void worldRemove(World *world, int slot){ // backward-shift deletion, so probes never need tombstones
+	int mask = world->tableSize - 1;
+	int hole = slot;
+	world->table[hole] = NULL;
+	for(int i = (hole + 1) & mask; world->table[i] != NULL; i = (i + 1) & mask){
+		int home = (int)(randomHash(0, worldKey(world->table[i]->cx, world->table[i]->cy)) & mask);
+		if(((i - home) & mask) >= ((i - hole) & mask)){
+			world->table[hole] = world->table[i];
+			world->table[i] = NULL;
+			hole = i;
+		}
+	}
+}
+
+void worldUse(World *world, WorldChunk *chunk){ // mark a chunk most recently used
+	world->recent = chunk;
+	if(world->newest == chunk)
+		return;
+	if(chunk->newer != NULL)
+		chunk->newer->older = chunk->older;
+	if(chunk->older != NULL)
+		chunk->older->newer = chunk->newer;
+	else if(world->oldest == chunk)
+		world->oldest = chunk->newer;
+	chunk->older = world->newest;
+	chunk->newer = NULL;
+	if(world->newest != NULL)
+		world->newest->newer = chunk;
+	world->newest = chunk;
+	if(world->oldest == NULL)
+		world->oldest = chunk;
+}
+
+WorldChunk *worldEvict(World *world){ // unlinks the least recently used chunk, NULL when its mask bits could not be spilled
+	WorldChunk *chunk = world->oldest;
+	if(worldSpill(world, chunk))
+		return NULL;
+	int slot = (int)(randomHash(0, worldKey(chunk->cx, chunk->cy)) & (world->tableSize - 1));
+	while(world->table[slot] != chunk)
+		slot = (slot + 1) & (world->tableSize - 1);
+	worldRemove(world, slot);
+	world->oldest = chunk->newer;
+	if(world->oldest != NULL)
+		world->oldest->older = NULL;
+	else
+		world->newest = NULL;
+	if(world->recent == chunk)
+		world->recent = NULL;
+	world->chunkTotal--;
+	world->evictions++;
+	return chunk;
+}
+
+long worldRecord(World *world, int32_t cx, int32_t cy, int create){ // spill file record of a chunk, -1 if it has none
+	int slot = (int)(randomHash(0, worldKey(cx, cy)) & (world->recordSize - 1));
+	while(world->record[slot].record >= 0){
+		if(world->record[slot].cx == cx && world->record[slot].cy == cy)
+			return world->record[slot].record;
+		slot = (slot + 1) & (world->recordSize - 1);
+	}
+	if(!create)
+		return -1;
+	
+	// keep the index at most half full
+	if((world->recordTotal + 1) * 2 > world->recordSize){
+		WorldRecord *old = world->record;
+		int oldSize = world->recordSize;
+		WorldRecord *record = malloc(sizeof(WorldRecord) * oldSize * 2);
+		if(record == NULL)
+			return -1;
+		world->record = record;
+		world->recordSize = oldSize * 2;
+		for(int r = 0; r < world->recordSize; r++)
+			record[r].record = -1;
+		for(int o = 0; o < oldSize; o++){
+			if(old[o].record < 0) continue;
+			int r = (int)(randomHash(0, worldKey(old[o].cx, old[o].cy)) & (world->recordSize - 1));
+			while(record[r].record >= 0)
+				r = (r + 1) & (world->recordSize - 1);
+			record[r] = old[o];
+		}
+		free(old);
+		slot = (int)(randomHash(0, worldKey(cx, cy)) & (world->recordSize - 1));
+		while(world->record[slot].record >= 0)
+			slot = (slot + 1) & (world->recordSize - 1);
+	}
+	world->record[slot].cx = cx;
+	world->record[slot].cy = cy;
+	world->record[slot].record = world->recordTotal++;
+	return world->record[slot].record;
+}
+
+int worldSpill(World *world, WorldChunk *chunk){
+	long record = worldRecord(world, chunk->cx, chunk->cy, 0);
+	if(record < 0){
+		
+		// chunks still wholly hidden regenerate as they were and need no record
+		int touched = 0;
+		for(int i = 0; i < WORLD_CHUNK * WORLD_CHUNK && !touched; i++)
+			touched = chunk->cell[i] >> CELL_MASK_SHIFT != 1;
+		if(!touched)
+			return 0;
+		record = worldRecord(world, chunk->cx, chunk->cy, 1);
+		if(record < 0)
+			return -1;
+	}
+	unsigned char bits[WORLD_RECORD];
+	for(int b = 0; b < WORLD_RECORD; b++){
+		unsigned char *cell = chunk->cell + b * 4;
+		bits[b] = (cell[0] >> CELL_MASK_SHIFT) | (cell[1] >> CELL_MASK_SHIFT << 2) | (cell[2] >> CELL_MASK_SHIFT << 4) | (cell[3] >> CELL_MASK_SHIFT << 6);
+	}
+	if(fseek(world->spill, record * WORLD_RECORD, SEEK_SET) || fwrite(bits, 1, WORLD_RECORD, world->spill) != WORLD_RECORD)
+		return -1;
+	world->spillWrites++;
+	return 0;
+}
+
+int worldRestore(World *world, WorldChunk *chunk){
+	long record = worldRecord(world, chunk->cx, chunk->cy, 0);
+	if(record < 0)
+		return 0;
+	unsigned char bits[WORLD_RECORD];
+	if(fseek(world->spill, record * WORLD_RECORD, SEEK_SET) || fread(bits, 1, WORLD_RECORD, world->spill) != WORLD_RECORD)
+		return -1;
+	for(int i = 0; i < WORLD_CHUNK * WORLD_CHUNK; i++)
+		chunk->cell[i] = (chunk->cell[i] & CELL_TILE) | (((bits[i >> 2] >> (i & 3) * 2) & 3) << CELL_MASK_SHIFT);
+	world->spillReads++;
+	return 0;
+}
+
+unsigned char *worldCell(World *world, int32_t x, int32_t y){
+	if(x < -WORLD_LIMIT || x >= WORLD_LIMIT || y < -WORLD_LIMIT || y >= WORLD_LIMIT)
+		return NULL;
+	WorldChunk *chunk = worldChunk(world, x >> WORLD_CHUNK_SHIFT, y >> WORLD_CHUNK_SHIFT);
+	if(chunk == NULL)
+		return NULL;
+	return chunk->cell + ((y & (WORLD_CHUNK - 1)) << WORLD_CHUNK_SHIFT) + (x & (WORLD_CHUNK - 1));
+}
+
+long long worldTileReveal(World *world, int32_t x, int32_t y){ // tiles revealed, -1 when a chunk could not be generated
+	unsigned char *cell = worldCell(world, x, y);
+	if(cell == NULL)
+		return -1;
+	if(*cell >> CELL_MASK_SHIFT != 1)
+		return 0;
+	*cell &= CELL_TILE;
+	long long revealed = 1;
+	int32_t *queue = world->revealQueue;
+	int queueSize = 0;
+	if((*cell & CELL_TILE) == 0){
+		queue[0] = x;
+		queue[1] = y;
+		queueSize = 1;
+	}
+	
+	// expand empty tiles, generating chunks as the region crosses into them
+	while(queueSize > 0){
+		queueSize--;
+		int32_t tx = queue[queueSize * 2];
+		int32_t ty = queue[queueSize * 2 + 1];
+		int lx = tx & (WORLD_CHUNK - 1);
+		int ly = ty & (WORLD_CHUNK - 1);
+		int inner = lx > 0 && lx < WORLD_CHUNK - 1 && ly > 0 && ly < WORLD_CHUNK - 1;
+		unsigned char *centre = inner ? worldCell(world, tx, ty) : NULL;
+		for(int n = 0; n < 9; n++){
+			if(n == 4) continue;
+			int32_t nx = tx + n % 3 - 1;
+			int32_t ny = ty + n / 3 - 1;
+			unsigned char *next;
+			if(inner)
+				next = centre + (n / 3 - 1) * WORLD_CHUNK + n % 3 - 1;
+			else{
+				if(nx < -WORLD_LIMIT || nx >= WORLD_LIMIT || ny < -WORLD_LIMIT || ny >= WORLD_LIMIT) continue;
+				next = worldCell(world, nx, ny);
+				if(next == NULL){
+					world->revealed += revealed;
+					return -1;
+				}
+			}
+			if(*next >> CELL_MASK_SHIFT != 1) continue;
+			*next &= CELL_TILE;
+			revealed++;
+			if((*next & CELL_TILE) != 0) continue;
+			if(queueSize == world->queueCapacity){
+				int32_t *grown = realloc(queue, sizeof(int32_t) * 4 * world->queueCapacity);
+				if(grown == NULL){
+					world->revealed += revealed;
+					return -1;
+				}
+				world->revealQueue = queue = grown;
+				world->queueCapacity *= 2;
+			}
+			queue[queueSize * 2] = nx;
+			queue[queueSize * 2 + 1] = ny;
+			queueSize++;
+		}
+	}
+	world->revealed += revealed;
+	return revealed;
+}
+
+size_t worldMemory(World *world){
+	return sizeof(World) + sizeof(WorldChunk*) * world->tableSize + sizeof(WorldChunk) * world->chunkTotal + sizeof(int32_t) * 2 * world->queueCapacity +
+		sizeof(WorldRecord) * world->recordSize;
+}
+
+// cleanup functions
+
+void worldCleanup(World *world){
+	if(world->table != NULL)
+		for(int t = 0; t < world->tableSize; t++)
+			free(world->table[t]);
+	free(world->table);
+	free(world->revealQueue);
+	free(world->record);
+	if(world->spill != NULL)
+		fclose(world->spill);
+}
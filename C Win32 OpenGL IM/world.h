@@ -0,0 +1,108 @@
+#ifndef WORLD
+#define WORLD
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdint.h>
+
+#include "board.h"
+
+#define WORLD_CHUNK_SHIFT 6
+#define WORLD_CHUNK (1 << WORLD_CHUNK_SHIFT) // chunk side in cells
+#define WORLD_LIMIT (1 << 30) // cells lie in [-WORLD_LIMIT, WORLD_LIMIT) on both axes
+#define WORLD_DENSITY_MIN 0.12 // sparser worlds could have empty regions without end
+#define WORLD_RECORD (WORLD_CHUNK * WORLD_CHUNK / 4) // bytes of a spilled chunk, two mask bits per cell
+
+// square of cells at chunk coordinate (cx, cy), packed as Game cells
+typedef struct WorldChunk{
+	int32_t cx;
+	int32_t cy;
+	struct WorldChunk *newer; // neighbours in the least recently used order of a session
+	struct WorldChunk *older;
+	unsigned char cell[WORLD_CHUNK * WORLD_CHUNK];
+}WorldChunk;
+
+// place in the spill file of a chunk evicted at least once
+typedef struct WorldRecord{
+	int32_t cx;
+	int32_t cy;
+	long record; // -1 for free slots
+}WorldRecord;
+
+// unbounded board, generated a chunk at a time from the seed as cells are first reached
+typedef struct World{
+	uint64_t seed;
+	uint64_t threshold; // cells whose hash falls below are mines
+	
+	// chunks generated so far
+	WorldChunk **table; // open-addressed by chunk coordinate, NULL for free slots
+	int tableSize; // power of two
+	int chunkTotal;
+	WorldChunk *recent; // last chunk looked up
+	
+	// session: at most chunkLimit chunks resident, evicting the least recently used to the spill file
+	int chunkLimit; // 0 to keep every chunk
+	WorldChunk *newest;
+	WorldChunk *oldest;
+	FILE *spill; // mask bits only, mines and counts are regenerated from the seed on reload
+	WorldRecord *record; // open-addressed by chunk coordinate
+	int recordSize; // power of two
+	int recordTotal;
+	long long hits;
+	long long misses;
+	long long evictions;
+	long long spillWrites;
+	long long spillReads;
+	
+	// operational
+	int32_t *revealQueue; // x and y of empty tiles still to be expanded
+	int queueCapacity;
+	
+	// game state
+	long long revealed;
+	int state; // 1: game in progress, 2: game lost
+}World;
+
+// setup
+int worldSetup(World *world, uint64_t seed, double density);
+int worldSession(World *world, int chunkLimit, const char *path);
+
+// moves (the 3x3 around the origin never holds a mine, so play starts by selecting (0, 0))
+void worldSelect(World *world, int32_t x, int32_t y);
+void worldFlag(World *world, int32_t x, int32_t y);
+
+// world operations
+uint64_t worldKey(int32_t x, int32_t y);
+int worldIsMine(World *world, int32_t x, int32_t y);
+WorldChunk *worldChunk(World *world, int32_t cx, int32_t cy);
+void worldGenerate(World *world, WorldChunk *chunk);
+int worldGrow(World *world);
+void worldRemove(World *world, int slot);
+void worldUse(World *world, WorldChunk *chunk);
+WorldChunk *worldEvict(World *world);
+long worldRecord(World *world, int32_t cx, int32_t cy, int create);
+int worldSpill(World *world, WorldChunk *chunk);
+int worldRestore(World *world, WorldChunk *chunk);
+unsigned char *worldCell(World *world, int32_t x, int32_t y);
+long long worldTileReveal(World *world, int32_t x, int32_t y);
+size_t worldMemory(World *world);
+
+// cleanup
+void worldCleanup(World *world);
+
+// cell access (as gameTile and gameMask, -2 for cells outside the world or not generated for lack of memory)
+
+static inline int worldTile(World *world, int32_t x, int32_t y){
+	unsigned char *cell = worldCell(world, x, y);
+	if(cell == NULL)
+		return -2;
+	int tile = *cell & CELL_TILE;
+	return tile == CELL_MINE ? -1 : tile;
+}
+
+static inline int worldMask(World *world, int32_t x, int32_t y){
+	unsigned char *cell = worldCell(world, x, y);
+	return cell == NULL ? -2 : *cell >> CELL_MASK_SHIFT;
+}
+
+#endif